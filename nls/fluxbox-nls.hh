@@ -246,6 +246,7 @@ enum {
 	mainScreenRequiresArg = 12,
 	mainUsage = 13,
 	mainWarnDisplayEnv = 14,
+	mainTRACERequiresArg = 15,
 
 	LayerSet = 20,
 	LayerAboveDock = 1,
@@ -255,6 +255,17 @@ bool ClientPattern::dependsOnCurrentWorkspace() const {
   return false;
 }
 
+bool ClientPattern::isTrackable() const {
+  if (m_matchlimit > 0 || dependsOnFocusedWindow() )
+    return false;
+  for (auto it : m_terms)
+    if (it->prop == WP::HEAD || it->prop == WP::VIEWABLE
+        || it->prop == WP::XPROP
+        || (it->prop == WP::WORKSPACENAME && it->regstr != "[current]") )
+      return false;
+  return true;
+}
+
 // add an expression to match against
 // The first argument is a regular expression, the second is the member
 // function that we wish to match against.
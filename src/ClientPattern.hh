@@ -44,6 +44,10 @@ public:
     bool dependsOnFocusedWindow() const;
     // Does this pattern depend on the current workspace?
     bool dependsOnCurrentWorkspace() const;
+    // Can matches be kept up to date from window and workspace changes?
+    // Not for the focused window, heads, viewable, xprops, workspace
+    // names (they can be renamed) or limits.
+    bool isTrackable() const;
 
     /**
      * Add an expression to match against
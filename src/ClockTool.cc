@@ -99,7 +99,7 @@ public:
       TextDialog(*Shynebox::instance()->mouseScreen(),
                  _SB_XTEXT(Toolbar, ClockEditFormat, "Edit Clock Format", "edit Clock Format") ),
       m_tool(tool) {
-    setText((string)*m_screen.m_cfgmap["strftimeFormat"]);
+    setText((string)*m_screen.m_cfg[tk::CFG_STRFTIME_FORMAT]);
   }
 
   void exec(const string &text) {
@@ -133,7 +133,7 @@ ClockTool::ClockTool(const tk::SbWindow &parent,
         m_theme(theme),
         m_screen(screen),
         m_pixmap(0),
-        m_timeformat(*screen.m_cfgmap["strftimeFormat"]),
+        m_timeformat(*screen.m_cfg[tk::CFG_STRFTIME_FORMAT]),
         m_stringconvertor(new tk::StringConvertor(tk::StringConvertor::ToSbString) ) {
   string time_locale = setlocale(LC_TIME, NULL);
   size_t pos = time_locale.find('.');
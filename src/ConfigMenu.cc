@@ -53,7 +53,7 @@ private:
 void ConfigMenu::setup(Menu& menu, BScreen &screen) {
   _SB_USES_NLS;
 
-  tk::CFGMAP &cfgmap = screen.m_cfgmap;
+  tk::ConfigManager &cfg = screen.m_cfg;
   Command<void> *shared_saverc = Shynebox::instance()->getSharedSaveRC();
   // shared commands
   // theyre all just calling funcs and it was a waste of space and overhead
@@ -93,19 +93,19 @@ void ConfigMenu::setup(Menu& menu, BScreen &screen) {
 
   fm->insertItem(new BoolMenuItem(_SB_XTEXT(Configmenu, FocusNew,
       "Focus New Windows", "Focus newly created windows"),
-      *cfgmap["focusNewWindows"], *shared_sv_rcfg_macro) );
+      *cfg[tk::CFG_FOCUS_NEW_WINDOWS], *shared_sv_rcfg_macro) );
 
   fm->insertItem(new tk::BoolMenuItem(_SB_XTEXT(Configmenu, FocusSameHead,
       "Keep Head", "Only revert focus on same head"),
-      *cfgmap["focusSameHead"], *shared_sv_rcfg_macro) );
+      *cfg[tk::CFG_FOCUS_SAME_HEAD], *shared_sv_rcfg_macro) );
 
 #define _BOOLITEM(m, a, b, c, d, e, f) (m).insertItem(new BoolMenuItem(_SB_XTEXT(a, b, c, d), e, f) )
   _BOOLITEM(*fm, Configmenu, AutoRaise,
             "Auto Raise Windows", "Auto Raise windows on sloppy",
-            *cfgmap["autoRaiseWindows"], *shared_sv_rcfg_macro);
+            *cfg[tk::CFG_AUTO_RAISE_WINDOWS], *shared_sv_rcfg_macro);
   _BOOLITEM(*fm, Configmenu, ClickRaises,
             "Click Raises Windows", "Click Raises",
-            *cfgmap["clickRaisesWindows"], *shared_sv_rcfg_macro);
+            *cfg[tk::CFG_CLICK_RAISES_WINDOWS], *shared_sv_rcfg_macro);
 
   menu.insertSubmenu(foc_model_label, fm);
   fm->updateMenu();
@@ -117,17 +117,17 @@ void ConfigMenu::setup(Menu& menu, BScreen &screen) {
 
   _BOOLITEM(*mm, Configmenu, FullMax,
             "Full Maximization", "Maximise over slit, toolbar, etc",
-            *cfgmap["fullMaximization"], *shared_saverc);
+            *cfg[tk::CFG_FULL_MAXIMIZATION], *shared_saverc);
   _BOOLITEM(*mm, Configmenu, MaxIgnoreInc,
             "Ignore Resize Increment",
             "Maximizing Ignores Resize Increment (e.g. xterm)",
-            *cfgmap["maxIgnoreIncrement"], *shared_saverc);
+            *cfg[tk::CFG_MAX_IGNORE_INCREMENT], *shared_saverc);
   _BOOLITEM(*mm, Configmenu, MaxDisableMove,
             "Disable Moving", "Don't Allow Moving While Maximized",
-            *cfgmap["maxDisableMove"], *shared_saverc);
+            *cfg[tk::CFG_MAX_DISABLE_MOVE], *shared_saverc);
   _BOOLITEM(*mm, Configmenu, MaxDisableResize,
             "Disable Resizing", "Don't Allow Resizing While Maximized",
-            *cfgmap["maxDisableResize"], *shared_saverc);
+            *cfg[tk::CFG_MAX_DISABLE_RESIZE], *shared_saverc);
 
   menu.insertSubmenu(max_label, mm);
   mm->updateMenu();
@@ -142,19 +142,19 @@ void ConfigMenu::setup(Menu& menu, BScreen &screen) {
 
   tab_menu->insertItem(new BoolMenuItem(_SB_XTEXT(Configmenu, TabsInTitlebar,
             "Tabs in Titlebar", "Tabs in Titlebar"),
-            *cfgmap["tabs.inTitlebar"], *shared_sv_rcfg_macro) );
+            *cfg[tk::CFG_TABS_IN_TITLEBAR], *shared_sv_rcfg_macro) );
   tab_menu->insertItem(new BoolMenuItem(_SB_XTEXT(Common, MaximizeOver,
             "Maximize Over", "Maximize over this thing when maximizing"),
-            *cfgmap["tabs.maxOver"], *shared_sv_rcfg_macro) );
+            *cfg[tk::CFG_TABS_MAX_OVER], *shared_sv_rcfg_macro) );
   tab_menu->insertItem(new BoolMenuItem(_SB_XTEXT(Toolbar, ShowIcons,
             "Show Pictures", "chooses if little icons are shown next to title in the iconbar"),
-            *cfgmap["tabs.usePixmap"], *shared_sv_rcfg_macro) );
+            *cfg[tk::CFG_TABS_USE_PIXMAP], *shared_sv_rcfg_macro) );
 
   MenuItem *tab_width_item =
       new IntMenuItem(_SB_XTEXT(Configmenu, ExternalTabWidth,
                                      "External Tab Width",
                                      "Width of external-style tabs"),
-                             *cfgmap["tabs.width"], 10, 3000, /* silly number */
+                             *cfg[tk::CFG_TABS_WIDTH], 10, 3000, /* silly number */
                              *tab_menu);
   tab_width_item->setCommand(*shared_sv_rcfg_macro);
   tab_menu->insertItem(tab_width_item);
@@ -201,23 +201,23 @@ void ConfigMenu::setup(Menu& menu, BScreen &screen) {
   _BOOLITEM(menu, Configmenu, OpaqueMove,
             "Opaque Window Moving",
             "Window Moving with whole window visible (as opposed to outline moving)",
-            *cfgmap["opaqueMove"], *shared_saverc);
+            *cfg[tk::CFG_OPAQUE_MOVE], *shared_saverc);
   _BOOLITEM(menu, Configmenu, OpaqueResize,
             "Opaque Window Resizing",
             "Window Resizing with whole window visible (as opposed to outline resizing)",
-            *cfgmap["opaqueResize"], *shared_saverc);
+            *cfg[tk::CFG_OPAQUE_RESIZE], *shared_saverc);
   _BOOLITEM(menu, Configmenu, WorkspaceWarping,
             "Warp Horizontal",
             "Warp Horizontal - dragging windows left-right warps workspaces",
-            *cfgmap["workspaceWarpingHorizontal"], *shared_saverc);
+            *cfg[tk::CFG_WORKSPACE_WARPING_HORIZONTAL], *shared_saverc);
   _BOOLITEM(menu, Configmenu, WorkspaceWarping,
             "Warp Vertical",
             "Warp Vertical - dragging windows up-down warps workspaces",
-            *cfgmap["workspaceWarpingVertical"], *shared_saverc);
+            *cfg[tk::CFG_WORKSPACE_WARPING_VERTICAL], *shared_saverc);
   _BOOLITEM(menu, Configmenu, FocusSameHead, // XINERAMA leftover of NLS
             "Obey Multi-Head",
             "Obey Multi-Head - Use randr's dimensions of heads(monitors) for positioning",
-            *cfgmap["obeyHeads"], *shared_sv_rcfg_macro);
+            *cfg[tk::CFG_OBEY_HEADS], *shared_sv_rcfg_macro);
 #undef _BOOLITEM
   menu.updateMenu();
 } // ConfigMenu::setup
@@ -312,11 +312,7 @@ void GoToTabCmd::real_execute() {
     num += sbwindow().numClients() + 1;
   num = clamp(num, 1, sbwindow().numClients() );
 
-  ShyneboxWindow::ClientList::iterator it = sbwindow().clientList().begin();
-
-  while (--num > 0) ++it;
-
-  (*it)->focus();
+  sbwindow().clientList()[num - 1]->focus();
 }
 
 REGISTER_COMMAND(startmoving, StartMovingCmd, void);
@@ -338,6 +338,8 @@ public:
       frame_extents = XInternAtom(disp, "_NET_FRAME_EXTENTS", False);
 
       wm_ping = XInternAtom(disp, "_NET_WM_PING", False);
+      wm_sync_request = XInternAtom(disp, "_NET_WM_SYNC_REQUEST", False);
+      wm_sync_request_counter = XInternAtom(disp, "_NET_WM_SYNC_REQUEST_COUNTER", False);
       utf8_string = XInternAtom(disp, "UTF8_STRING", False);
   };
 
@@ -381,6 +383,8 @@ public:
 
   // application protocols
   Atom wm_ping;
+  Atom wm_sync_request;
+  Atom wm_sync_request_counter;
 
   Atom utf8_string;
 }; // EwmhAtoms
@@ -518,8 +522,15 @@ void Ewmh::initForScreen(BScreen &screen) {
     m_net->desktop_viewport,
     m_net->desktop_geometry,
 
-    m_net->supporting_wm_check
+    m_net->supporting_wm_check,
+
+    // protocols, keep these last, they go when the server has no XSync
+    m_net->wm_sync_request,
+    m_net->wm_sync_request_counter
   };
+  unsigned int num_supported = (sizeof atomsupported)/sizeof atomsupported[0];
+  if (!Shynebox::instance()->haveSync() )
+    num_supported -= 2;
   /* From Extended Window Manager Hints, draft 1.3:
    *
    * _NET_SUPPORTED, ATOM[]/32
@@ -536,7 +547,7 @@ void Ewmh::initForScreen(BScreen &screen) {
   screen.rootWindow().changeProperty(m_net->supported, XA_ATOM, 32,
                                      PropModeReplace,
                                      (unsigned char *) &atomsupported,
-                                     (sizeof atomsupported)/sizeof atomsupported[0]);
+                                     num_supported);
 
   // update atoms
   updateWorkspaceCount(screen);
@@ -1173,16 +1184,10 @@ bool Ewmh::propertyNotify(WinClient &winclient, Atom the_property) {
     updateStrut(winclient);
     return true;
   } else if (the_property == m_net->wm_name) {
+    // read and set on the client's title timer, so a client spamming
+    // titles is rate limited like WM_NAME is.
     // This is ignored by client if title was set manually
-    tk::SbString newtitle = winclient.textProperty(the_property);
-    if (!newtitle.empty() )
-      winclient.setTitle(newtitle);
-      // moved toolbar/iconbar update to
-      // SbWindow::setTitle() which is called in client's setTitle()
-      // helps with performance of things like urxvt doing some kinda
-      // of xterm compat double title set
-    if (winclient.sbwindow() )
-      winclient.sbwindow()->frame().clearAll();
+    winclient.netTitleChanged(the_property);
     return true;
   } else if (the_property == m_net->wm_icon_name) {
     // we don't use icon title, since we don't show icons
@@ -14,6 +14,8 @@
 #include "tk/EventManager.hh"
 #include "tk/KeyUtil.hh"
 
+#include <algorithm>
+
 #include <unistd.h>
 
 #define MainFocEnum tk::MainFocusModel_e
@@ -26,6 +28,10 @@ bool FocusControl::s_reverting = false;
 
 namespace {
 
+// cached filtered lists per screen. every one of them is matched again
+// on window updates, so old patterns must not pile up
+const size_t MAX_FILTERED_LISTS = 16;
+
 bool doSkipWindow(const Focusable &win, const ClientPattern *pat) {
   const ShyneboxWindow *sbwin = win.sbwindow();
   if (!sbwin || sbwin->isFocusHidden() || sbwin->isModal() )
@@ -40,20 +46,25 @@ bool doSkipWindow(const Focusable &win, const ClientPattern *pat) {
 
 FocusControl::FocusControl(BScreen &screen):
     m_screen(screen),
-    m_focus_model((MainFocEnum&)(int&)(*screen.m_cfgmap["focusModel"]) ),
-    m_tab_focus_model((TabFocEnum&)(int&)(*screen.m_cfgmap["tabs.focusModel"]) ),
-    m_focus_new(*screen.m_cfgmap["focusNewWindows"]),
-    m_focus_same_head(*screen.m_cfgmap["focusSameHead"]),
+    m_focus_model((MainFocEnum&)(int&)(*screen.m_cfg[tk::CFG_FOCUS_MODEL]) ),
+    m_tab_focus_model((TabFocEnum&)(int&)(*screen.m_cfg[tk::CFG_TABS_FOCUS_MODEL]) ),
+    m_focus_new(*screen.m_cfg[tk::CFG_FOCUS_NEW_WINDOWS]),
+    m_focus_same_head(*screen.m_cfg[tk::CFG_FOCUS_SAME_HEAD]),
     m_focused_list(screen),     m_creation_order_list(screen),
     m_focused_win_list(screen), m_creation_order_win_list(screen),
+    m_cycling_window(0),
     m_cycling_list(0),
     m_was_iconic(0),
     m_cycling_last(0),
     m_cycling_next(0),
     m_ignore_mouse_x(-1), m_ignore_mouse_y(-1) {
-  m_cycling_window = m_focused_list.clientList().end();
 } // FocusControl class init
 
+FocusControl::~FocusControl() {
+  for (auto it : m_filtered_lists)
+    delete it.second.list;
+} // FocusControl class destroy
+
 void FocusControl::cycleFocus(const FocusableList &window_list,
                               const ClientPattern *pat, bool cycle_reverse) {
     if (!m_cycling_list) {
@@ -66,19 +77,23 @@ void FocusControl::cycleFocus(const FocusableList &window_list,
     } else if (m_cycling_list != &window_list)
       m_cycling_list = &window_list;
 
-    Focusables::const_iterator it_begin = window_list.clientList().begin();
-    Focusables::const_iterator it_end = window_list.clientList().end();
+    // focus(), setCurrentClient() and deiconify() below report the
+    // window as updated, which can take it out of a filtered list.
+    // walk a copy so that can't pull the iterator out from under us
+    const Focusables list = window_list.clientList();
+    Focusables::const_iterator it_begin = list.begin();
+    Focusables::const_iterator it_end = list.end();
 
     // too many things can go wrong with remembering this
-    m_cycling_window = it_end;
+    Focusables::const_iterator start = it_end;
     if (m_cycling_next)
-      m_cycling_window = find(it_begin, it_end, m_cycling_next);
-    if (m_cycling_window == it_end)
-      m_cycling_window = find(it_begin, it_end, s_focused_window);
-    if (m_cycling_window == it_end)
-      m_cycling_window = find(it_begin, it_end, s_focused_sbwindow);
+      start = std::find(it_begin, it_end, m_cycling_next);
+    if (start == it_end && s_focused_window)
+      start = std::find(it_begin, it_end, s_focused_window);
+    if (start == it_end && s_focused_sbwindow)
+      start = std::find(it_begin, it_end, s_focused_sbwindow);
 
-    Focusables::const_iterator it = m_cycling_window;
+    Focusables::const_iterator it = start;
     ShyneboxWindow *sbwin = 0;
     WinClient *last_client = 0;
     WinClient *was_iconic = 0;
@@ -92,7 +107,7 @@ void FocusControl::cycleFocus(const FocusableList &window_list,
       else
         cycle_reverse ? --it : ++it;
       // give up [do nothing] if we reach the current focused again
-      if (it == m_cycling_window)
+      if (it == start)
         return;
       if (it == it_end)
         continue;
@@ -110,7 +125,7 @@ void FocusControl::cycleFocus(const FocusableList &window_list,
         break;
       m_cycling_next = 0;
     } // while true
-    m_cycling_window = it;
+    m_cycling_window = *it;
 
     // if we're still in the same sbwin, there's nothing else to do
     if (m_cycling_last && m_cycling_last->sbwindow() == sbwin)
@@ -135,6 +150,71 @@ void FocusControl::cycleFocus(const FocusableList &window_list,
     m_was_iconic = was_iconic;
 } // cycleFocus
 
+const FocusableList *FocusControl::filteredList(int opts,
+                                               const ClientPattern &pat) {
+  if (pat.error() || !pat.isTrackable() )
+    return 0;
+
+  opts &= FocusableList::LIST_GROUPS | FocusableList::STATIC_ORDER;
+  std::string key = pat.toString();
+  key += (char)('0' + opts);
+
+  auto it = m_filtered_lists.find(key);
+  if (it != m_filtered_lists.end() ) {
+    it->second.used = ++m_filter_uses;
+    return it->second.list;
+  }
+
+  // full, drop the one used longest ago
+  if (m_filtered_lists.size() >= MAX_FILTERED_LISTS) {
+    auto old = m_filtered_lists.end();
+    for (auto f = m_filtered_lists.begin(); f != m_filtered_lists.end(); ++f)
+      if (f->second.list != m_cycling_list
+          && (old == m_filtered_lists.end() || f->second.used < old->second.used) )
+        old = f;
+    if (old != m_filtered_lists.end() ) {
+      delete old->second.list;
+      m_filtered_lists.erase(old);
+    }
+  }
+
+  FilteredList &f = m_filtered_lists[key];
+  f.list = new FocusableList(m_screen,
+                             *FocusableList::getListFromOptions(m_screen, opts),
+                             pat.toString() );
+  f.used = ++m_filter_uses;
+  return f.list;
+}
+
+// the list being cycled through is kept, cycling still points into it
+void FocusControl::pruneFilteredLists() {
+  auto it = m_filtered_lists.begin();
+  while (it != m_filtered_lists.end() ) {
+    if (it->second.list == m_cycling_list) {
+      ++it;
+      continue;
+    }
+    delete it->second.list;
+    it = m_filtered_lists.erase(it);
+  }
+}
+
+void FocusControl::windowUpdated(ShyneboxWindow &win) {
+  for (auto client : win.clientList() ) {
+    m_focused_list.windowUpdated(*client);
+    m_creation_order_list.windowUpdated(*client);
+  }
+  m_focused_win_list.windowUpdated(win);
+  m_creation_order_win_list.windowUpdated(win);
+}
+
+void FocusControl::workspaceChanged() {
+  m_focused_list.workspaceChanged();
+  m_creation_order_list.workspaceChanged();
+  m_focused_win_list.workspaceChanged();
+  m_creation_order_win_list.workspaceChanged();
+}
+
 void FocusControl::goToWindowNumber(const FocusableList &winlist, int num,
                                     const ClientPattern *pat) {
   Focusables list = winlist.clientList();
@@ -304,10 +384,8 @@ void FocusControl::removeClient(WinClient &client) {
   if (client.screen().isShuttingdown() )
     return;
 
-  if (isCycling()
-      && m_cycling_window != m_cycling_list->clientList().end()
-      && *m_cycling_window == &client) {
-    m_cycling_window = m_cycling_list->clientList().end();
+  if (isCycling() && m_cycling_window == &client) {
+    m_cycling_window = 0;
     stopCyclingFocus();
   } else if (m_cycling_last == &client)
     m_cycling_last = 0;
@@ -323,10 +401,8 @@ void FocusControl::removeWindow(Focusable &win) {
   if (win.screen().isShuttingdown() )
     return;
 
-  if (isCycling()
-      && m_cycling_window != m_cycling_list->clientList().end()
-      && *m_cycling_window == &win) {
-    m_cycling_window = m_cycling_list->clientList().end();
+  if (isCycling() && m_cycling_window == &win) {
+    m_cycling_window = 0;
     stopCyclingFocus();
   }
 
@@ -337,7 +413,7 @@ void FocusControl::removeWindow(Focusable &win) {
 
 void FocusControl::shutdown() {
   // restore windows backwards so they get put back correctly on restart
-  Focusables::reverse_iterator it = m_focused_list.clientList().rbegin();
+  Focusables::const_reverse_iterator it = m_focused_list.clientList().rbegin();
   for (; it != m_focused_list.clientList().rend(); ++it) {
     WinClient *client = dynamic_cast<WinClient *>(*it);
     if (client && client->sbwindow() )
@@ -9,6 +9,8 @@
 #define FOCUSCONTROL_HH
 
 #include <list>
+#include <map>
+#include <string>
 
 #include "tk/Config.hh"
 #include "FocusableList.hh"
@@ -24,6 +26,7 @@ public:
   typedef std::list<Focusable *> Focusables;
 
   explicit FocusControl(BScreen &screen);
+  ~FocusControl();
   void prevFocus() { cycleFocus(m_focused_list, 0, true); }
   void nextFocus() { cycleFocus(m_focused_list, 0, false); }
   // Cycle focus for a set of windows.
@@ -75,6 +78,15 @@ public:
   const FocusableList &focusedOrderList() const { return m_focused_list; }
   const FocusableList &creationOrderWinList() const { return m_creation_order_win_list; }
   const FocusableList &focusedOrderWinList() const { return m_focused_win_list; }
+  // the list for opts filtered by pat, kept up to date while it is one
+  // of the last few asked for. 0 if the pattern can't be kept up to date
+  const FocusableList *filteredList(int opts, const ClientPattern &pat);
+  // keys were reloaded, drop the lists the old commands asked for
+  void pruneFilteredLists();
+
+  // win or one of its clients changed something patterns match on
+  void windowUpdated(ShyneboxWindow &win);
+  void workspaceChanged();
 
   // remove client from focus list
   void removeClient(WinClient &client);
@@ -108,8 +120,16 @@ private:
                 m_creation_order_list,
                 m_focused_win_list,
                 m_creation_order_win_list;
-
-  Focusables::const_iterator m_cycling_window;
+  // filtered lists asked for by commands, by options and pattern.
+  // only the MAX_FILTERED_LISTS used last are kept
+  struct FilteredList {
+    FocusableList *list;
+    unsigned long used;
+  };
+  std::map<std::string, FilteredList> m_filtered_lists;
+  unsigned long m_filter_uses = 0;
+
+  Focusable *m_cycling_window; // where the last cycle step stopped
   const FocusableList *m_cycling_list;
   Focusable *m_was_iconic;
   WinClient *m_cycling_last;
@@ -10,6 +10,8 @@
 
 #include "tk/StringUtil.hh"
 
+#include <algorithm>
+#include <iterator>
 #include <vector>
 
 #include "Debug.hh"
@@ -65,6 +67,7 @@ FocusableList::FocusableList(BScreen &scr, const string & pat):
   m_pat = new ClientPattern(pattern.c_str() );
 
   addMatching();
+  m_parent->m_views.push_back(this);
 }
 
 FocusableList::FocusableList(BScreen &scr, const FocusableList &parent,
@@ -72,9 +75,17 @@ FocusableList::FocusableList(BScreen &scr, const FocusableList &parent,
       m_pat(new ClientPattern(pat.c_str() ) ),
       m_parent(&parent), m_screen(scr) {
   addMatching();
+  m_parent->m_views.push_back(this);
 } // FocusableList class init
 
 FocusableList::~FocusableList() {
+  if (m_parent) {
+    vector<FocusableList *> &views = m_parent->m_views;
+    views.erase(std::remove(views.begin(), views.end(), this), views.end() );
+  }
+  for (auto it : m_views)
+    it->m_parent = 0;
+
   if (m_pat)
     delete m_pat;
 } // FocusableList class destroy
@@ -87,59 +98,194 @@ void FocusableList::addMatching() {
 
   for (auto &it : list) {
     if (m_pat->match(*it) ) {
-      m_list.push_back(it);
+      link(*it, false);
       m_pat->addMatch();
     }
   }
 }
 
+// a window is only ever in the list once, linking it again moves it
+void FocusableList::link(Focusable &win, bool front) {
+  Focusables::iterator pos = front ? m_list.begin() : m_list.end();
+  auto it = m_index.find(&win);
+  if (it != m_index.end() )
+    m_list.splice(pos, m_list, it->second);
+  else
+    m_index[&win] = m_list.insert(pos, &win);
+}
+
+void FocusableList::unlink(Focusable &win) {
+  auto it = m_index.find(&win);
+  if (it == m_index.end() )
+    return;
+
+  m_list.erase(it->second);
+  m_index.erase(it);
+  for (auto view : m_views)
+    view->remove(win);
+}
+
+// the parent got win pushed to one end, follow it there if it belongs here
+void FocusableList::parentPushed(Focusable &win, bool front) {
+  if (!contains(win) ) {
+    if (!m_pat->match(win) )
+      return;
+    m_pat->addMatch();
+  }
+
+  if (front)
+    pushFront(win);
+  else
+    pushBack(win);
+}
+
+// new member of a filtered list, keep it in the same order as the parent.
+// it goes in front of the next window after it that is in here too
+void FocusableList::insertInOrder(Focusable &win) {
+  Focusables::const_iterator pit = m_parent->position(&win),
+                             pit_end = m_parent->m_list.end();
+  Focusables::iterator pos = m_list.end();
+  if (pit != pit_end)
+    for (++pit; pit != pit_end; ++pit) {
+      auto it = m_index.find(*pit);
+      if (it != m_index.end() ) {
+        pos = it->second;
+        break;
+      }
+    }
+
+  m_index[&win] = m_list.insert(pos, &win);
+}
+
 void FocusableList::pushFront(Focusable &win) {
-  m_list.push_front(&win);
+  link(win, true);
+  for (auto view : m_views)
+    view->parentPushed(win, true);
 }
 
 void FocusableList::pushBack(Focusable &win) {
-  m_list.push_back(&win);
+  link(win, false);
+  for (auto view : m_views)
+    view->parentPushed(win, false);
 }
 
+// if the window isn't already in this list, we could accidentally add it
 void FocusableList::moveToFront(Focusable &win) {
-  // if the window isn't already in this list, we could accidentally add it
-  if (!contains(win) )
+  auto it = m_index.find(&win);
+  if (it == m_index.end() )
     return;
 
-  m_list.remove(&win);
-  m_list.push_front(&win);
+  m_list.splice(m_list.begin(), m_list, it->second);
+  for (auto view : m_views)
+    view->moveToFront(win);
 }
 
 void FocusableList::moveToBack(Focusable &win) {
-  // if the window isn't already in this list, we could accidentally add it
-  if (!contains(win) )
+  auto it = m_index.find(&win);
+  if (it == m_index.end() )
     return;
 
-  m_list.remove(&win);
-  m_list.push_back(&win);
+  m_list.splice(m_list.end(), m_list, it->second);
+  for (auto view : m_views)
+    view->moveToBack(win);
 }
 
 void FocusableList::remove(Focusable &win) {
-  // if the window isn't already in this list, we could send a bad signal
-  bool contained = contains(win);
+  if (!contains(win) )
+    return;
 
-  if (!contained)
+  unlink(win);
+  if (m_pat)
+    m_pat->removeMatch();
+}
+
+void FocusableList::windowUpdated(Focusable &win) {
+  if (m_parent && m_pat) {
+    bool had = contains(win);
+    if (had) // don't count win against itself
+      m_pat->removeMatch();
+
+    if (m_parent->contains(win) && m_pat->match(win) ) {
+      m_pat->addMatch();
+      if (!had)
+        insertInOrder(win);
+    } else {
+      if (had)
+        unlink(win);
+      return; // nothing below us can have it now
+    }
+  }
+
+  for (auto view : m_views)
+    view->windowUpdated(win);
+}
+
+void FocusableList::workspaceChanged() {
+  if (m_parent && m_pat && m_pat->dependsOnCurrentWorkspace() ) {
+    refilter();
     return;
+  }
 
-  m_list.remove(&win);
+  for (auto view : m_views)
+    view->workspaceChanged();
+}
+
+// match the whole parent again in one pass. windows that stay are left
+// where they are, the list is always in the same order as the parent
+void FocusableList::refilter() {
+  Focusables::iterator pos = m_list.begin();
+  for (auto win : m_parent->m_list) {
+    auto it = m_index.find(win);
+    bool had = it != m_index.end();
+    if (had)
+      m_pat->removeMatch();
+
+    bool match = m_pat->match(*win);
+    if (match)
+      m_pat->addMatch();
+
+    if (had && match)
+      pos = std::next(it->second);
+    else if (match)
+      m_index[win] = m_list.insert(pos, win);
+    else if (had) {
+      if (pos == it->second)
+        ++pos;
+      unlink(*win);
+    }
+  }
+
+  for (auto view : m_views)
+    view->refilter();
 }
 
 void FocusableList::reset() {
   m_list.clear();
+  m_index.clear();
   if (m_pat)
     m_pat->resetMatches();
   if (m_parent)
     addMatching();
+
+  for (auto view : m_views)
+    view->reset();
+}
+
+void FocusableList::refresh() {
+  if (m_pat && !m_pat->isTrackable() )
+    reset();
 }
 
 bool FocusableList::contains(const Focusable &win) const {
-  auto it = std::find(m_list.begin(), m_list.end(), &win);
-  return it != m_list.end();
+  return m_index.find(&win) != m_index.end();
+}
+
+FocusableList::Focusables::const_iterator
+FocusableList::position(const Focusable *win) const {
+  auto it = m_index.find(win);
+  if (it == m_index.end() )
+    return m_list.end();
+  return it->second;
 }
 
 Focusable *FocusableList::find(const ClientPattern &pat) const {
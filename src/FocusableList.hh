@@ -3,6 +3,16 @@
 /*
   Creates list of focusables based on ClientPatterns.
   Mostly used for Iconbar, but also key commands, and misc loops.
+
+  Every focus change moves windows around in several of these, so the
+  position of each window is kept in an index. Lookups, moves and
+  removals don't walk the list.
+
+  Lists made from a parent stay attached to it. Whatever is pushed,
+  moved or removed in the parent is passed on, and windowUpdated()
+  checks the pattern again for just the one window that changed. So a
+  filtered list never has to be rebuilt unless its pattern depends on
+  things nobody reports (see ClientPattern::isTrackable).
 */
 
 #ifndef FOCUSABLELIST_HH
@@ -13,6 +23,8 @@
 #include "ClientPattern.hh"
 
 #include <list>
+#include <unordered_map>
+#include <vector>
 
 class BScreen;
 class Focusable;
@@ -45,23 +57,37 @@ public:
   void moveToBack(Focusable &win);
   void remove(Focusable &win);
 
-  Focusables &clientList() { return m_list; }
   const Focusables &clientList() const { return m_list; }
 
   bool empty() const { return m_list.empty(); }
   bool contains(const Focusable &win) const;
+  // where win is in the list, end() if it isn't
+  Focusables::const_iterator position(const Focusable *win) const;
   Focusable *find(const ClientPattern &pattern) const;
 
-  void windowUpdated(ShyneboxWindow &sbwin);
+  // match win again after something it can be matched on changed
+  void windowUpdated(Focusable &win);
+  // the current workspace changed
+  void workspaceChanged();
   void reset();
+  // reset if the pattern can't be kept up to date
+  void refresh();
 
 private:
   void addMatching();
+  void link(Focusable &win, bool front);
+  void unlink(Focusable &win);
+  void parentPushed(Focusable &win, bool front);
+  void insertInOrder(Focusable &win);
+  void refilter();
 
   ClientPattern *m_pat = 0;
   const FocusableList *m_parent;
   BScreen &m_screen;
-  std::list<Focusable *> m_list;
+  Focusables m_list;
+  std::unordered_map<const Focusable *, Focusables::iterator> m_index;
+  // lists filtered from this one
+  mutable std::vector<FocusableList *> m_views;
 };
 
 #endif // FOCUSABLELIST_HH
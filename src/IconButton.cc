@@ -58,12 +58,14 @@ void IconButton::leaveNotifyEvent(XCrossingEvent &ev) {
   m_win.screen().hideTooltip();
 }
 
+// buttons that keep their size (most of them on a single add/remove)
+// keep their background and icon as they are
 void IconButton::moveResize(int x, int y,
                             unsigned int width, unsigned int height) {
   tk::TextButton::moveResize(x, y, width, height);
 
-  if (m_icon_window.width() != tk::Button::width()
-      || m_icon_window.height() != tk::Button::height() ) {
+  if (m_rendered_w != tk::Button::width()
+      || m_rendered_h != tk::Button::height() ) {
     reconfigTheme();
     refreshEverything(false); // update icon window
   }
@@ -71,8 +73,8 @@ void IconButton::moveResize(int x, int y,
 
 void IconButton::resize(unsigned int width, unsigned int height) {
   tk::TextButton::resize(width, height);
-  if (m_icon_window.width() != tk::Button::width()
-      || m_icon_window.height() != tk::Button::height() ) {
+  if (m_rendered_w != tk::Button::width()
+      || m_rendered_h != tk::Button::height() ) {
     reconfigTheme();
     refreshEverything(false); // update icon window
   }
@@ -80,7 +82,7 @@ void IconButton::resize(unsigned int width, unsigned int height) {
 
 void IconButton::showTooltip() {
  int xoffset = 1;
- if (m_icon_pixmap.drawable() != 0)
+ if (m_has_icon)
    xoffset = m_icon_window.x() + m_icon_window.width() + 1;
 
   if (tk::TextButton::textExceeds(xoffset) )
@@ -122,6 +124,21 @@ void IconButton::reconfigTheme() {
     m_pm.reset(0);
     setBackgroundColor(m_theme->texture().color() );
   }
+
+  m_rendered_w = width();
+  m_rendered_h = height();
+  m_rendered_focus = m_win.isFocused();
+  m_need_clear = true;
+}
+
+bool IconButton::refresh() {
+  if (m_rendered_focus != m_win.isFocused() )
+    reconfigTheme();
+  else if (!m_need_clear && text().logical() == displayTitle() )
+    return false;
+
+  clear();
+  return true;
 }
 
 void IconButton::reconfigAndClear() {
@@ -132,6 +149,7 @@ void IconButton::reconfigAndClear() {
 void IconButton::refreshEverything(bool setup) {
   Display *display = tk::App::instance()->display();
   int screen = m_win.screen().screenNumber();
+  const tk::PixmapWithMask *icon = 0;
 
   if (m_use_pixmap
        && m_win.icon().pixmap().drawable() != None
@@ -156,35 +174,31 @@ void IconButton::refreshEverything(bool setup) {
 
     m_icon_window.moveResize(iconx, icony, neww, newh);
 
-    m_icon_pixmap.copy(m_win.icon().pixmap().drawable(),
-                       DefaultDepth(display, screen), screen);
-    m_icon_pixmap.scale(m_icon_window.width(), m_icon_window.height() );
-
-    // rotate the icon or not?? lets go not for now, and see what they say...
-    // need to rotate mask too if we do do this
-    m_icon_pixmap.rotate(orientation() );
+    // scaled once per icon and size, shared with other buttons/menus
+    tk::IconCache &cache = m_win.screen().imageControl().iconCache();
+    icon = cache.scaled(m_win.icon(),
+                        m_icon_window.width(), m_icon_window.height(),
+                        DefaultDepth(display, screen), orientation() );
+  } // if pixmap drawable and width check
 
-    m_icon_window.setBackgroundPixmap(m_icon_pixmap.drawable() );
+  // the window keeps its own reference to the background, so the cache
+  // can drop the pixmap whenever the icon changes
+  if (icon) {
+    m_icon_window.setBackgroundPixmap(icon->pixmap().drawable() );
+    m_has_icon = true;
   } else {
     // no icon pixmap
     m_icon_window.move(0, 0);
     m_icon_window.hide();
-    m_icon_pixmap = 0;
-  } // if pixmap drawable and width check
-
-  if (m_icon_pixmap.drawable() && m_win.icon().mask().drawable() != None) {
-    m_icon_mask.copy(m_win.icon().mask().drawable(), 0, 0);
-    m_icon_mask.scale(m_icon_pixmap.width(), m_icon_pixmap.height() );
-    m_icon_mask.rotate(orientation() );
-  } else
-    m_icon_mask = 0;
+    m_has_icon = false;
+  }
 
 #ifdef SHAPE
   XShapeCombineMask(display,
                     m_icon_window.drawable(),
                     ShapeBounding,
                     0, 0,
-                    m_icon_mask.drawable(),
+                    icon ? icon->mask().drawable() : None,
                     ShapeSet);
 #endif // SHAPE
 
@@ -194,19 +208,24 @@ void IconButton::refreshEverything(bool setup) {
     m_icon_window.clear();
 } // refreshEverything
 
+tk::SbString IconButton::displayTitle() const {
+  if (m_win.sbwindow() && m_win.sbwindow()->isIconic() )
+    return IconbarTool::iconifiedPrefix() + m_win.title().logical()
+           + IconbarTool::iconifiedSuffix();
+  return m_win.title().logical();
+}
+
 void IconButton::setupWindow() {
   m_icon_window.clear();
-  tk::SbString title = m_win.title().logical();
-  if (m_win.sbwindow() && m_win.sbwindow()->isIconic() )
-    title = IconbarTool::iconifiedPrefix() + title + IconbarTool::iconifiedSuffix();
-  setText(title);
+  setText(displayTitle() );
   tk::TextButton::clear();
+  m_need_clear = false;
 }
 
 void IconButton::drawText(int x, int y, tk::SbDrawable *drawable) {
   if (width() > m_icon_window.width() ) {
     x = 1;
-    if (m_icon_pixmap.drawable() != 0) // offset text
+    if (m_has_icon) // offset text
       x += m_icon_window.x() + m_icon_window.width();
     tk::TextButton::drawText(x, y, drawable);
   }
@@ -233,7 +252,7 @@ unsigned int IconButton::preferredWidth() const {
   unsigned int r2 = TextButton::preferredWidth();
   that->setFont(that->m_theme->text().font() );
   r = std::max(r, r2);
-  if (m_icon_pixmap.drawable() )
+  if (m_has_icon)
     r += m_icon_window.width() + 1;
   return r;
 }
@@ -12,6 +12,7 @@
 #include "FocusableTheme.hh"
 
 #include "tk/CachedPixmap.hh"
+#include "tk/ObjectPool.hh"
 #include "tk/SbPixmap.hh"
 #include "tk/TextButton.hh"
 
@@ -23,6 +24,8 @@ template <class T> class ThemeProxy;
 
 class IconButton: public tk::TextButton {
 public:
+  TK_POOLED(IconButton)
+
   IconButton(const tk::SbWindow &parent,
              tk::ThemeProxy<IconbarTheme> &focused_theme,
              tk::ThemeProxy<IconbarTheme> &unfocused_theme,
@@ -41,6 +44,9 @@ public:
   void resize(unsigned int width, unsigned int height);
 
   void reconfigTheme();
+  // render/redraw only if focus, size or title changed since last time
+  // returns true if something was drawn
+  bool refresh();
 
   void setPixmap(bool use);
 
@@ -58,6 +64,7 @@ protected:
 private:
   void reconfigAndClear();
   void setupWindow();
+  tk::SbString displayTitle() const;
 
   // Refresh all windows
   // setup will setup window again.
@@ -65,14 +72,18 @@ private:
 
   Focusable &m_win;
   tk::SbWindow m_icon_window;
-  tk::SbPixmap m_icon_pixmap;
-  tk::SbPixmap m_icon_mask;
+  bool m_has_icon = false;
   bool m_use_pixmap;
   // if enter notify hit ~this~ is showing its tooltip
   bool m_has_tooltip;
   FocusableTheme<IconbarTheme> m_theme;
   // cached pixmaps
   tk::CachedPixmap m_pm;
+
+  // what the background was last rendered for
+  unsigned int m_rendered_w = 0, m_rendered_h = 0;
+  bool m_rendered_focus = false;
+  bool m_need_clear = false;
 };
 
 #endif // ICONBUTTON_HH
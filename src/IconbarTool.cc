@@ -186,11 +186,11 @@ IconbarTool::IconbarTool(const tk::SbWindow &parent, IconbarTheme &theme,
       m_empty_pm(screen.imageControl() ),
       m_winlist(new FocusableList(screen) ),
       m_mode("none"),
-      m_rc_mode(*screen.m_cfgmap["iconbar.mode"]),
-      m_rc_alignment((BTAlignEnum&)(int&)(*screen.m_cfgmap["iconbar.alignment"]) ),
-      m_rc_client_width(*screen.m_cfgmap["iconbar.iconWidth"]),
-      m_rc_client_padding(*screen.m_cfgmap["iconbar.iconTextPadding"]),
-      m_rc_use_pixmap(*screen.m_cfgmap["iconbar.usePixmap"]),
+      m_rc_mode(*screen.m_cfg[tk::CFG_ICONBAR_MODE]),
+      m_rc_alignment((BTAlignEnum&)(int&)(*screen.m_cfg[tk::CFG_ICONBAR_ALIGNMENT]) ),
+      m_rc_client_width(*screen.m_cfg[tk::CFG_ICONBAR_ICON_WIDTH]),
+      m_rc_client_padding(*screen.m_cfg[tk::CFG_ICONBAR_ICON_TEXT_PADDING]),
+      m_rc_use_pixmap(*screen.m_cfg[tk::CFG_ICONBAR_USE_PIXMAP]),
       m_menu(screen.menuTheme(), screen.imageControl(),
              *screen.layerManager().getLayer((int)tk::ResLayers_e::MENU) ) {
 
@@ -365,8 +365,14 @@ void IconbarTool::update(UpdateReason reason, Focusable *win) {
 
   switch(reason) {
     case LIST_ADD:
-      if (!win->isTransient() )
+      // the list matched the new window against the mode already
+      if (!win->isTransient() && m_winlist->contains(*win) )
         insertWindow(*win);
+      else if (!win->isTransient() && win->sbwindow() ) { // list of clients
+        for (auto client : win->sbwindow()->clientList() )
+          if (m_winlist->contains(*client) )
+            insertWindow(*client);
+      }
       resetLock();
       break;
     case LIST_REMOVE:
@@ -390,16 +396,17 @@ void IconbarTool::update(UpdateReason reason, Focusable *win) {
   m_icon_container.update();
   m_icon_container.showSubwindows();
 
-  // renderTheme() is needed due to multiple alignment types
-  // (smart)relative will require a update for every button
-  // focus/unfocus always requires at least 2 button updates
-  // may be able to reduce overhead for focus or fixed aligns
-  // but not really worth it
-  renderTheme();
+  // only the buttons that changed are drawn again. a button that got a
+  // new size already rendered its background while being repositioned
+  // (and shares it with same sized buttons through the image cache),
+  // the rest only redraw on focus or title changes
+  renderEmpty();
+  for (auto icon_it : m_icons)
+    icon_it.second->refresh();
 } // update
 
 void IconbarTool::updateIconifiedPattern() {
-  std::string p = *m_screen.m_cfgmap["iconbar.iconifiedPattern"];
+  std::string p = *m_screen.m_cfg[tk::CFG_ICONBAR_ICONIFIED_PATTERN];
   size_t tidx = p.find("%t");
   s_iconifiedDecoration[0].clear();
   s_iconifiedDecoration[1].clear();
@@ -428,7 +435,7 @@ void IconbarTool::insertWindow(Focusable &win) {
 
 void IconbarTool::reset() {
   deleteIcons();
-  m_winlist->reset();
+  m_winlist->refresh(); // follows window changes by itself
 
   for (auto it : m_winlist->clientList() )
     if (it->sbwindow() )
@@ -443,21 +450,33 @@ void IconbarTool::updateSizing() {
   m_icon_container.setBorderColor(m_theme.border().color() );
 }
 
-void IconbarTool::renderTheme() {
-  // update button sizes before container gets max width per client!
-  updateSizing();
+// background for the part of the container without buttons
+void IconbarTool::renderEmpty(bool force) {
+  if (!force && m_empty_w == m_icon_container.width()
+      && m_empty_h == m_icon_container.height() )
+    return;
+
+  m_empty_w = m_icon_container.width();
+  m_empty_h = m_icon_container.height();
 
-  // if we dont have any icons then we should render empty texture
   if (!m_theme.emptyTexture().usePixmap() ) {
     m_empty_pm.reset(0);
     m_icon_container.setBackgroundColor(m_theme.emptyTexture().color() );
   } else {
     m_empty_pm.reset(m_screen.imageControl().
-                     renderImage(m_icon_container.width(),
-                                 m_icon_container.height(),
+                     renderImage(m_empty_w, m_empty_h,
                                  m_theme.emptyTexture(), orientation() ) );
     m_icon_container.setBackgroundPixmap(m_empty_pm);
   }
+}
+
+// full render, for theme/size/mode changes
+void IconbarTool::renderTheme() {
+  // update button sizes before container gets max width per client!
+  updateSizing();
+
+  // if we dont have any icons then we should render empty texture
+  renderEmpty(true);
 
   // update buttons
   for (auto icon_it : m_icons)
@@ -69,6 +69,7 @@ private:
   // render single button, and probably apply changes (clear)
   void renderButton(IconButton &button, bool clear = true);
   void renderTheme();
+  void renderEmpty(bool force = false);
   void deleteIcons();
   void insertWindow(Focusable &win);
   void removeWindow(Focusable &win);
@@ -90,6 +91,7 @@ private:
   IconbarTheme &m_theme;
   tk::ThemeProxy<IconbarTheme> &m_focused_theme, &m_unfocused_theme;
   tk::CachedPixmap m_empty_pm; // pixmap for empty container
+  unsigned int m_empty_w = 0, m_empty_h = 0;
 
   // focusable list
   FocusableList *m_winlist = 0;
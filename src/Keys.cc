@@ -97,6 +97,28 @@ int extractKeyFromString(const std::string& in, const char* start_pattern, unsig
   return ret;
 }
 
+// keymode a line adds its binding to, empty for blank lines and comments
+// (same rules as addBinding)
+string lineMode(const string &line) {
+  const char *delim = " \t\n";
+  string::size_type first = line.find_first_not_of(delim);
+  if (first == string::npos || line[first] == '#' || line[first] == '!')
+    return string();
+
+  string::size_type last = line.find_first_of(delim, first);
+  if (last == string::npos)
+    last = line.size();
+  if (line[last - 1] == ':')
+    return line.substr(first, last - first);
+  return "default:";
+}
+
+// client frames only get their button grabs once the pointer is in them,
+// there can be hundreds and most are never clicked before the next change
+bool lazyGrabs(int context) {
+  return context == Keys::ON_WINDOW;
+}
+
 } // end of anonymous namespace
 
 // class that holds a specific key-binding-to-action
@@ -162,8 +184,6 @@ Keys::Keys():
 } // Keys class init
 
 Keys::~Keys() {
-  ungrabKeys();
-  ungrabButtons();
   deleteTree();
   if (m_reloader)
     delete m_reloader;
@@ -171,8 +191,7 @@ Keys::~Keys() {
 
 /// Destroys the keytree
 void Keys::deleteTree() {
-  ungrabKeys();
-  ungrabButtons();
+  ungrabAll();
   for (auto m : m_map) {
     if (m.second == m_keylist)
       m_keylist = 0;
@@ -182,42 +201,60 @@ void Keys::deleteTree() {
   if (m_keylist)
     delete m_keylist;
   m_keylist = 0;
+  m_file_hash = 0;
+  m_mode_src.clear();
+  m_mode_links.clear();
   // saved/next keys are just pointers to the actual keylist
   next_key = 0;
   saved_keymode = 0;
 }
 
 // keys are only grabbed in global context
-void Keys::grabKey(unsigned int key, unsigned int mod) {
-  for (auto it : m_window_map)
-    if ((it.second & Keys::GLOBAL) > 0)
-      tk::KeyUtil::grabKey(key, mod, it.first);
-}
-
-// keys are only grabbed in global context
-void Keys::ungrabKeys() {
-  for (auto it : m_window_map)
+void Keys::ungrabAll() {
+  for (auto it : m_window_map) {
     if ((it.second & Keys::GLOBAL) > 0)
       tk::KeyUtil::ungrabKeys(it.first);
+    tk::KeyUtil::ungrabButtons(it.first);
+  }
+  m_grabs.clear();
+  m_pending.clear();
 }
 
-// ON_DESKTOP context doesn't need to be grabbed
-void Keys::grabButton(unsigned int button, unsigned int mod, int context) {
-  for (auto it : m_window_map)
-    if ((context & it.second & ~Keys::ON_DESKTOP) > 0)
-      tk::KeyUtil::grabButton(button, mod, it.first,
-                              ButtonPressMask|ButtonReleaseMask);
+Keys::GrabSet Keys::windowGrabs(const GrabSet &grabs, int context) {
+  GrabSet ret;
+  for (auto &g : grabs) {
+    // keys are only grabbed in global context
+    // ON_DESKTOP buttons don't need to be grabbed
+    if (g.type == KeyPress ? (context & Keys::GLOBAL) > 0
+                           : (context & g.context & ~Keys::ON_DESKTOP) > 0)
+      ret.insert(Grab{g.type, g.key, g.mod, 0});
+  }
+  return ret;
 }
 
-void Keys::ungrabButtons() {
-  for (auto it : m_window_map)
-    tk::KeyUtil::ungrabButtons(it.first);
+void Keys::changeGrabs(Window win, const GrabSet &from, const GrabSet &to) {
+  for (auto &g : from) {
+    if (to.find(g) != to.end() )
+      continue;
+    if (g.type == KeyPress)
+      tk::KeyUtil::ungrabKey(g.key, g.mod, win);
+    else
+      tk::KeyUtil::ungrabButton(g.key, g.mod, win);
+  }
+
+  for (auto &g : to) {
+    if (from.find(g) != from.end() )
+      continue;
+    if (g.type == KeyPress)
+      tk::KeyUtil::grabKey(g.key, g.mod, win);
+    else
+      tk::KeyUtil::grabButton(g.key, g.mod, win,
+                              ButtonPressMask|ButtonReleaseMask);
+  }
 }
 
+// window must not have any of our grabs yet
 void Keys::grabWindow(Window win) {
-  if (!m_keylist)
-    return;
-
   // make sure the window is in our list
   WindowMap::iterator win_it = m_window_map.find(win);
   if (win_it == m_window_map.end() )
@@ -225,16 +262,8 @@ void Keys::grabWindow(Window win) {
 
   // orig click to focus
   m_handler_map[win]->grabButtons();
-  for (auto it : m_keylist->keylist) {
-    // keys are only grabbed in global context
-    if ((win_it->second & Keys::GLOBAL) > 0 && it->type == KeyPress)
-      tk::KeyUtil::grabKey(it->key, it->mod, win);
-    // ON_DESKTOP buttons don't need to be grabbed
-    else if ((win_it->second & it->context & ~Keys::ON_DESKTOP) > 0) {
-      if ((it->type & (ButtonPress | ButtonRelease) ) )
-        tk::KeyUtil::grabButton(it->key, it->mod, win, ButtonPressMask|ButtonReleaseMask);
-    }
-  }
+  changeGrabs(win, GrabSet(), windowGrabs(m_grabs, win_it->second) );
+  m_pending.erase(win);
 } // grabWindow - for click to focus
 
 // Load and grab keys from file
@@ -248,34 +277,113 @@ void Keys::reload() {
     return; // failed to open file - back out
   }
 
-  // free memory of previous grabs
-  deleteTree();
-
-  m_map["default:"] = new t_key;
-
-  size_t current_line = 0,
-         parsed_cnt = 0;
-
+  vector<string> lines;
+  string contents;
   while (!infile.eof() ) {
     string linebuffer;
     getline(infile, linebuffer);
-    current_line++;
+    contents += linebuffer;
+    contents += '\n';
+    lines.push_back(linebuffer);
+  } // end while eof
+
+  if (lines.empty() ) {
+    loadDefaults(); // empty file somehow, may have corruption?
+    return;
+  }
 
-    if (!addBinding(linebuffer) ) {
+  // most reloads come from a touched but unchanged file
+  const size_t hash = std::hash<string>()(contents);
+  if (hash == m_file_hash && !m_map.empty() && !m_keymap_changed) {
+    if (m_keylist != m_map["default:"])
+      keyMode("default");
+    return;
+  }
+
+  // group lines by keymode, only modes whose lines differ get parsed again
+  ModeSource src;
+  vector<string> line_mode(lines.size() );
+  for (size_t i = 0; i < lines.size(); i++) {
+    line_mode[i] = lineMode(lines[i]);
+    if (!line_mode[i].empty() )
+      src[line_mode[i]] += lines[i] + '\n';
+  }
+
+  std::set<string> rebuild;
+  for (auto &m : src) {
+    ModeSource::iterator it = m_mode_src.find(m.first);
+    if (m_keymap_changed || it == m_mode_src.end() || it->second != m.second
+        || m_map.find(m.first) == m_map.end() )
+      rebuild.insert(m.first);
+  }
+  for (auto &m : m_mode_src)
+    if (src.find(m.first) == src.end() ) // mode was removed
+      rebuild.insert(m.first);
+  // modes that didn't come from the file are loadDefaults() leftovers.
+  // a file with no bindings at all has to clear those too
+  for (auto &m : m_map)
+    if (m_mode_src.find(m.first) == m_mode_src.end() )
+      rebuild.insert(m.first);
+
+  // a KeyMode binding in one mode adds 'None Escape' to the other
+  vector<string> todo(rebuild.begin(), rebuild.end() );
+  while (!todo.empty() ) {
+    ModeLinks::iterator it = m_mode_links.find(todo.back() );
+    todo.pop_back();
+    if (it == m_mode_links.end() )
+      continue;
+    for (auto &m : it->second)
+      if (rebuild.insert(m).second)
+        todo.push_back(m);
+  }
+
+  // linked modes are rebuilt together, so no other mode points at these
+  for (auto &m : rebuild) {
+    keyspace_t::iterator it = m_map.find(m);
+    if (it != m_map.end() ) {
+      if (it->second == m_keylist)
+        m_keylist = 0;
+      delete it->second;
+      m_map.erase(it);
+    }
+    m_mode_src.erase(m);
+    m_mode_links.erase(m);
+  }
+  if (!rebuild.empty() )
+    next_key = saved_keymode = 0;
+
+  if (m_map.find("default:") == m_map.end() )
+    m_map["default:"] = new t_key;
+
+  for (size_t i = 0; i < lines.size(); i++) {
+    if (line_mode[i].empty() || rebuild.find(line_mode[i]) == rebuild.end() )
+      continue;
+
+    m_building = line_mode[i];
+    if (!addBinding(lines[i]) ) {
       _SB_USES_NLS;
       cerr << _SB_CONSOLETEXT(Keys, InvalidKeyMod,
               "Keys: Invalid key/modifier on line",
               "A bad key/modifier string was found on line (number following)")
-           <<" "<< current_line<<"): "<<linebuffer<<"\n";
-    } else
-      parsed_cnt++;
-  } // end while eof
+           <<" "<< i + 1<<"): "<<lines[i]<<"\n";
+    }
+  }
+  m_building.clear();
 
-  if (parsed_cnt == 0 && current_line == 0)
-    loadDefaults(); // empty file somehow, may have corruption?
-    // only comments will still allow 0 binds in case that's desired
+  for (auto &m : rebuild)
+    if (src.find(m) != src.end() )
+      m_mode_src[m] = src[m];
+  m_file_hash = hash;
+  m_keymap_changed = false;
+
+  // patterns of the old commands have no use for their filtered lists
+  if (!rebuild.empty() )
+    for (auto screen : Shynebox::instance()->screenList() )
+      screen->focusControl().pruneFilteredLists();
 
-  keyMode("default");
+  // grabs only change when the default mode was rebuilt
+  if (m_keylist != m_map["default:"])
+    keyMode("default");
 } // reload
 
 // Load critical key/mouse bindings for when there are fatal errors reading the keyFile.
@@ -315,13 +423,21 @@ bool Keys::addBinding(const string &linebuffer) {
   size_t argc = 0;
   t_key *current_key = m_map["default:"];
   t_key *first_new_keylist = m_map["default:"], *first_new_key = 0;
+  string mode = "default:";
 
   if (val[0][val[0].length()-1] == ':') {
     argc++;
-    keyspace_t::iterator it = m_map.find(val[0] );
+    mode = val[0];
+    keyspace_t::iterator it = m_map.find(mode);
     if (it == m_map.end() )
-      m_map[val[0] ] = new t_key;
-    current_key = m_map[val[0] ];
+      m_map[mode] = new t_key;
+    current_key = m_map[mode];
+  }
+
+  // parsing a line of another mode, e.g. a KeyMode command adding its escape
+  if (!m_building.empty() && mode != m_building) {
+    m_mode_links[mode].insert(m_building);
+    m_mode_links[m_building].insert(mode);
   }
 
   // for each argument
@@ -552,7 +668,11 @@ bool Keys::doAction(int type, unsigned int mods, unsigned int key,
 void Keys::registerWindow(Window win, tk::EventHandler &h, int context) {
   m_window_map[win] = context;
   m_handler_map[win] = &h;
-  grabWindow(win);
+  if (lazyGrabs(context) ) {
+    h.grabButtons();
+    m_pending.insert(win);
+  } else
+    grabWindow(win);
 }
 
 /// remove the window from the window map, probably being deleted
@@ -561,6 +681,19 @@ void Keys::unregisterWindow(Window win) {
   tk::KeyUtil::ungrabButtons(win);
   m_handler_map.erase(win);
   m_window_map.erase(win);
+  m_pending.erase(win);
+  if (m_pointer_win == win)
+    m_pointer_win = None;
+}
+
+void Keys::windowEntered(Window win) {
+  m_pointer_win = win;
+  if (m_pending.erase(win) == 0)
+    return;
+
+  // may still have grabs of an older keymode
+  tk::KeyUtil::ungrabButtons(win);
+  grabWindow(win);
 }
 
 /**
@@ -585,24 +718,43 @@ void Keys::keyMode(const string& keyMode) {
 }
 
 void Keys::setKeyMode(t_key &keyMode) {
-  ungrabKeys();
-  ungrabButtons();
-
-  // notify handlers that their buttons have been ungrabbed
-  for (auto h_it : m_handler_map)
-    h_it.second->grabButtons();
-
+  GrabSet grabs;
   for (auto it : keyMode.keylist) {
     if (it->type == KeyPress) {
       if (!it->key_str.empty() ) {
         int key = tk::KeyUtil::getKey(it->key_str.c_str() );
         it->key = key;
       }
-      grabKey(it->key, it->mod);
-    } else
-      grabButton(it->key, it->mod, it->context);
+      if (it->key != 0) // would be AnyKey, symbol is not on this keyboard
+        grabs.insert(Grab{KeyPress, it->key, it->mod, 0});
+    } else if (it->type == ButtonPress || it->type == ButtonRelease)
+      grabs.insert(Grab{ButtonPress, it->key, it->mod, it->context});
   } // for keyMode.keylist
   m_keylist = &keyMode;
+
+  if (grabs == m_grabs)
+    return;
+
+  // only touch what changed, windows with the same context share the diff
+  typedef std::pair<GrabSet, GrabSet> Change;
+  std::map<int, Change> changes;
+  for (auto it : m_window_map) {
+    std::map<int, Change>::iterator c = changes.find(it.second);
+    if (c == changes.end() )
+      c = changes.insert(std::make_pair(it.second,
+                         Change(windowGrabs(m_grabs, it.second),
+                                windowGrabs(grabs, it.second) ) ) ).first;
+
+    const Change &change = c->second;
+    if (change.first == change.second
+        || m_pending.find(it.first) != m_pending.end() )
+      continue;
+    if (lazyGrabs(it.second) && it.first != m_pointer_win)
+      m_pending.insert(it.first);
+    else
+      changeGrabs(it.first, change.first, change.second);
+  }
+  m_grabs.swap(grabs);
 } // setKeyMode - think layers or emacs
 
 // Copyright (c) 2023 Shynebox - zlice
@@ -34,6 +34,14 @@
   doAction() searches the current keymap[keymode] t_key(and keylist)
   for matches then executes the configured command (action).
 
+  reload() keeps the parsed tree of every keymode whose lines are unchanged
+  and only regrabs when the default mode had to be rebuilt. A KeyMode command
+  adds its escape binding to the target mode, so modes tied together that
+  way are rebuilt together.
+
+  setKeyMode() only grabs and ungrabs what differs between the old and new
+  mode. Client frames (ON_WINDOW) are left alone until the pointer enters
+  them, see windowEntered().
 */
 
 #ifndef KEYS_HH
@@ -44,6 +52,7 @@
 #include <X11/Xlib.h>
 #include <string>
 #include <map>
+#include <set>
 
 class WinClient;
 
@@ -83,11 +92,16 @@ public:
   // register a window so that proper keys/buttons get grabbed on it
   void registerWindow(Window win, tk::EventHandler &handler, int context);
   void unregisterWindow(Window win);
+  // pointer entered a registered window, grabs buttons it is still missing
+  void windowEntered(Window win);
 
   // reset current key mode/map
   // this is called when MappingNotify hits the main WM event handler
   // see Shynebox init() key reloader and timer
   void regrab();
+  // keycodes and modifiers of parsed bindings may be stale, the next
+  // reload parses every mode again even if the file is unchanged
+  void keymapChanged() { m_keymap_changed = true; }
   // reset key maps and load configuration from file
   void reload();
   // calls reload when WM reconfigures
@@ -102,13 +116,37 @@ private:
   typedef std::map<std::string, t_key*> keyspace_t;
   typedef std::map<Window, int> WindowMap;
   typedef std::map<Window, tk::EventHandler*> HandlerMap;
+  typedef std::map<std::string, std::string> ModeSource;
+  typedef std::map<std::string, std::set<std::string> > ModeLinks;
+
+  // a key or button combination as grabbed on the server
+  struct Grab {
+    int type; // KeyPress or ButtonPress
+    unsigned int key, mod;
+    int context;
+
+    bool operator<(const Grab &o) const {
+      if (type != o.type)
+        return type < o.type;
+      if (key != o.key)
+        return key < o.key;
+      if (mod != o.mod)
+        return mod < o.mod;
+      return context < o.context;
+    }
+    bool operator==(const Grab &o) const {
+      return type == o.type && key == o.key && mod == o.mod
+          && context == o.context;
+    }
+  };
+  typedef std::set<Grab> GrabSet;
 
   void deleteTree();
 
-  void grabKey(unsigned int key, unsigned int mod);
-  void ungrabKeys();
-  void grabButton(unsigned int button, unsigned int mod, int context);
-  void ungrabButtons();
+  void ungrabAll();
+  // the grabs a window with 'context' needs out of 'grabs'
+  static GrabSet windowGrabs(const GrabSet &grabs, int context);
+  static void changeGrabs(Window win, const GrabSet &from, const GrabSet &to);
   void grabWindow(Window win);
 
   // Load default keybindings for when there are errors loading the keys file
@@ -120,11 +158,19 @@ private:
   tk::AutoReloadHelper* m_reloader = 0;
   t_key *m_keylist; // "Mod4 k :CmdHere"
   keyspace_t m_map; // map of Keymodes
+  size_t m_file_hash = 0; // contents of the last loaded file
+  bool m_keymap_changed = false; // since the last reload
+  ModeSource m_mode_src; // lines each keymode was built from
+  ModeLinks m_mode_links; // keymodes that add bindings to each other
+  std::string m_building; // keymode of the line being parsed in reload()
   t_key *next_key;
   t_key *saved_keymode;
 
   WindowMap m_window_map;
   HandlerMap m_handler_map;
+  GrabSet m_grabs; // of the current keymode
+  std::set<Window> m_pending; // client frames missing the current m_grabs
+  Window m_pointer_win = None; // last entered window
 };
 
 #endif // KEYS_HH
@@ -5,9 +5,11 @@
 #include "Screen.hh"
 #include "SbWinFrameTheme.hh"
 
+#include "tk/GContext.hh"
 #include "tk/ImageControl.hh"
 
 void OSDWindow::reconfigTheme() {
+  m_shown.clear();
   setBorderWidth(m_theme->border().width() );
   setBorderColor(m_theme->border().color() );
 
@@ -18,7 +20,8 @@ void OSDWindow::reconfigTheme() {
               & tk::Texture::PARENTRELATIVE) {
     if (!m_theme->titleTexture().usePixmap() ) {
         m_pixmap = None;
-        setBackgroundColor(m_theme->titleTexture().color() );
+        m_color = m_theme->titleTexture().color();
+        setBackgroundColor(m_color);
     } else {
       m_pixmap = m_screen.imageControl().renderImage(width(), height(),
                  m_theme->titleTexture() );
@@ -27,7 +30,8 @@ void OSDWindow::reconfigTheme() {
   } else {
     if (!m_theme->iconbarTheme().texture().usePixmap() ) {
       m_pixmap = None;
-      setBackgroundColor(m_theme->iconbarTheme().texture().color() );
+      m_color = m_theme->iconbarTheme().texture().color();
+      setBackgroundColor(m_color);
     } else {
       m_pixmap = m_screen.imageControl().renderImage(width(), height(),
                  m_theme->iconbarTheme().texture() );
@@ -44,12 +48,43 @@ void OSDWindow::resizeForText(const tk::BiDiString &text) {
 }
 
 void OSDWindow::showText(const tk::BiDiString &text) {
+  if (m_visible && text.logical() == m_shown)
+    return;
+
+  const int x = m_theme->bevelWidth(),
+            y = m_theme->bevelWidth() + m_theme->font().ascent();
+  GC text_gc = m_theme->iconbarTheme().text().textGC();
+
+  // what's below shows through, we can't keep a copy of that
+  if (m_pixmap == ParentRelative) {
+    m_shown.clear();
+    show();
+    clear();
+    m_theme->font().drawText(*this, m_screen.screenNumber(), text_gc,
+                             text, x, y);
+    return;
+  }
+
+  if (m_text_pm.drawable() == None || m_text_pm.width() != width()
+      || m_text_pm.height() != height() ) {
+    m_text_pm = None;
+    m_text_pm.create(window(), width(), height(), depth() );
+  }
+
+  tk::GContext gc(m_text_pm);
+  if (m_pixmap)
+    m_text_pm.copyArea(m_pixmap, gc.gc(), 0, 0, 0, 0, width(), height() );
+  else {
+    gc.setForeground(m_color);
+    m_text_pm.fillRectangle(gc.gc(), 0, 0, width(), height() );
+  }
+  m_theme->font().drawText(m_text_pm, m_screen.screenNumber(), text_gc,
+                           text, x, y);
+
+  m_shown = text.logical();
+  setBackgroundPixmap(m_text_pm.drawable() );
   show();
   clear();
-  m_theme->font().drawText(*this, m_screen.screenNumber(),
-          m_theme->iconbarTheme().text().textGC(), text,
-          m_theme->bevelWidth(),
-          m_theme->bevelWidth() + m_theme->font().ascent() );
 }
 
 void OSDWindow::show() {
@@ -68,6 +103,7 @@ void OSDWindow::hide() {
   if (!m_visible)
     return;
   m_visible = false;
+  m_shown.clear();
   tk::SbWindow::hide();
 }
 
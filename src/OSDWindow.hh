@@ -11,6 +11,10 @@
 #define OSDWINDOW_HH
 
 #include "tk/SbWindow.hh"
+#include "tk/SbPixmap.hh"
+#include "tk/Color.hh"
+
+#include <string>
 
 class BScreen;
 class SbWinFrameTheme;
@@ -48,7 +52,13 @@ private:
   BScreen &m_screen;
   tk::ThemeProxy<SbWinFrameTheme> &m_theme;
   Pixmap m_pixmap;
+  tk::Color m_color; // background when there's no m_pixmap
   bool m_visible;
+  // background with the text drawn in, the server keeps it on screen
+  // through exposes and re-shows
+  tk::SbPixmap m_text_pm;
+  // what's in m_text_pm, position/geometry ask again on every motion event
+  std::string m_shown;
 };
 
 #endif // OSDWINDOW_HH
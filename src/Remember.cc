@@ -17,10 +17,13 @@
 #include "tk/FileUtil.hh"
 #include "tk/MenuItem.hh"
 #include "tk/AutoReloadHelper.hh"
+#include "tk/FileSaver.hh"
 #include "tk/Config.hh"
 
 #include <cstring>
 #include <set>
+#include <sstream>
+#include <vector>
 
 using std::cerr;
 using std::string;
@@ -558,10 +561,18 @@ Remember::Remember():
 
   tk::Command<void> *reload_cmd = new tk::SimpleCommand<Remember>(*this, &Remember::reload);
   m_reloader->setReloadCmd(*reload_cmd);
+
+  tk::Command<void> *save_cmd = new tk::SimpleCommand<Remember>(*this, &Remember::writeApps);
+  m_save_timer.setTimeout(500 * tk::SbTime::IN_MILLISECONDS);
+  m_save_timer.setCommand(*save_cmd);
+  m_save_timer.fireOnce(true);
   reconfigure();
 } // Remember class init
 
 Remember::~Remember() {
+  if (m_save_timer.isTiming() )
+    writeApps();
+
   // the patterns free the "Application"s
   // the client mapping shouldn't need cleaning
   Patterns::iterator it;
@@ -627,6 +638,16 @@ void Remember::reconfigure() {
 }
 
 void Remember::checkReload() {
+  const string apps_string = expandFilename(Shynebox::instance()->getAppsFilename() );
+  // what we have is newer than the file until it's written
+  if (m_save_timer.isTiming() || tk::FileSaver::instance().isPending(apps_string) )
+    return;
+
+  // update timestamp to avoid unnecessary reload
+  if (m_own_write) {
+    m_own_write = false;
+    m_reloader->addFile(apps_string);
+  }
   m_reloader->checkReload();
 }
 
@@ -764,16 +785,33 @@ void Remember::reload() {
 } // reload
 
 void Remember::save() {
+  if (!m_save_timer.isTiming() )
+    m_save_timer.start();
+}
+
+void Remember::writeApps() {
+  m_save_timer.stop();
   string apps_string = tk::StringUtil::expandFilename(Shynebox::instance()->getAppsFilename() );
 
   sbdbg<<"("<<__FUNCTION__<<"): Saving apps file ["<<apps_string<<"]\n";
 
-  ofstream apps_file(apps_string.c_str() );
+  tk::FileSaver::instance().write(apps_string, appsString() );
+  m_own_write = true;
+} // writeApps
+
+string Remember::appsString() const {
+  std::ostringstream apps_file;
 
   // first of all we output all the startup commands
   for (auto sit : m_startups)
     apps_file<<"[startup] "<<sit<<"\n";
 
+  // members of each group, in file order
+  std::map<Application *, std::vector<ClientPattern *> > groups;
+  for (auto it : *m_pats)
+    if (it.second->is_grouped)
+      groups[it.second].push_back(it.first);
+
   set<Application *> grouped_apps; // no duplicates
 
   for (auto it : *m_pats) {
@@ -789,10 +827,9 @@ void Remember::save() {
         apps_file << " " << a.group_pattern->toString();
       apps_file << "\n";
 
-      for (auto git : *m_pats)
-        if (git.second == &a)
-          apps_file << (a.is_transient ? " [transient]" : " [app]") <<
-                                         git.first->toString()<<"\n";
+      for (auto pat : groups[&a])
+        apps_file << (a.is_transient ? " [transient]" : " [app]") <<
+                                       pat->toString()<<"\n";
     } else
       apps_file << (a.is_transient ? "[transient]" : "[app]") <<
                    it.first->toString()<<"\n";
@@ -933,10 +970,8 @@ void Remember::save() {
       apps_file << "  [Close]\t{" << ((a.save_on_close)?"yes":"no") << "}\n";
     apps_file << "[end]\n";
   } // for m_pats
-  apps_file.close();
-  // update timestamp to avoid unnecessary reload
-  m_reloader->addFile(Shynebox::instance()->getAppsFilename() );
-} // save
+  return apps_file.str();
+} // appsString
 
 bool Remember::isRemembered(WinClient &winclient, Attribute attrib) {
   Application *app = find(winclient);
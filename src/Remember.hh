@@ -9,6 +9,7 @@
 
 #include <X11/Xlib.h>
 #include "ClientPattern.hh"
+#include "tk/Timer.hh"
 
 #include <map>
 
@@ -76,6 +77,7 @@ public:
   void reconfigure();
   void checkReload();
   void reload();
+  // writes the apps file shortly after, saves close together write once
   void save();
 
   bool isRemembered(WinClient &win, Attribute attrib);
@@ -94,6 +96,9 @@ public:
   static Remember &instance() { return *s_instance; }
 
 private:
+  void writeApps();
+  std::string appsString() const;
+
   Patterns *m_pats = 0;
   Clients m_clients;
 
@@ -101,6 +106,8 @@ private:
   static Remember *s_instance;
 
   tk::AutoReloadHelper* m_reloader;
+  tk::Timer m_save_timer;
+  bool m_own_write = false; // file changed, but by us
 };
 
 #endif // REMEMBER_HH
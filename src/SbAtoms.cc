@@ -17,6 +17,8 @@ SbAtoms::SbAtoms() {
   xa_wm_take_focus = XInternAtom(dpy, "WM_TAKE_FOCUS", False);
   motif_wm_info = XInternAtom(dpy, "_MOTIF_WM_INFO", False);
   motif_wm_hints = XInternAtom(dpy, "_MOTIF_WM_HINTS", False);
+  net_wm_sync_request = XInternAtom(dpy, "_NET_WM_SYNC_REQUEST", False);
+  net_wm_sync_request_counter = XInternAtom(dpy, "_NET_WM_SYNC_REQUEST_COUNTER", False);
 
   s_singleton = this;
 } // SBAtoms class init
@@ -21,6 +21,8 @@ public:
   Atom getWMProtocolsAtom() const { return xa_wm_protocols; }
   Atom getWMTakeFocusAtom() const { return xa_wm_take_focus; }
   Atom getMWMHintsAtom() const { return motif_wm_hints; }
+  Atom getWMSyncRequestAtom() const { return net_wm_sync_request; }
+  Atom getWMSyncCounterAtom() const { return net_wm_sync_request_counter; }
 
 private:
   SbAtoms();
@@ -32,6 +34,8 @@ private:
   Atom xa_wm_delete_window;
   Atom xa_wm_take_focus;
   Atom xa_wm_change_state;
+  Atom net_wm_sync_request;
+  Atom net_wm_sync_request_counter;
 };
 
 #endif //SBATOMS_HH
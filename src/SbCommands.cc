@@ -20,13 +20,24 @@
 
 #include <unistd.h> // fork, setsid, execl
 
+#ifdef HAVE_POSIX_SPAWN
+#include <spawn.h>
+#include <signal.h>
+#include <cstring>
+#endif // HAVE_POSIX_SPAWN
+
 #include <fstream>
 #include <iostream>
+#include <vector>
 
 #if defined(__EMX__) && defined(HAVE_PROCESS_H)
 #include <process.h> // for P_NOWAIT
 #endif // __EMX__
 
+#if defined(HAVE_POSIX_SPAWN) && defined(POSIX_SPAWN_SETSID)
+extern char **environ;
+#endif
+
 using std::string;
 using std::ofstream;
 using std::ios;
@@ -96,10 +107,6 @@ int ExecuteCmd::run() {
 
   return spawnlp(P_NOWAIT, comspec, comspec, "/c", m_cmd.c_str(), static_cast<void*>(NULL) );
 #else
-  pid_t pid = fork();
-  if (pid)
-    return pid;
-
   // 'display' is given as 'host:number.screen'. we want to give the
   // new app a good home, so we remove '.screen' from what is given
   // us from the xserver and replace it with the screen_num of the Screen
@@ -117,17 +124,57 @@ int ExecuteCmd::run() {
   display += '.';
   display += tk::StringUtil::number2String(screen_num);
 
-  tk::App::setenv("DISPLAY", display.c_str() );
-
   const char *shell = getenv("SHELL");
   if (!shell)
     shell = "/bin/sh";
 
+#if defined(HAVE_POSIX_SPAWN) && defined(POSIX_SPAWN_SETSID)
+  // fork() copies the page tables of the whole WM, so launching got
+  // slower the more windows/pixmaps/fonts we held. posix_spawn shares
+  // our memory until the exec, everything the child needs is prepared
+  // here. the SIGCHLD handler reaps it.
+  string display_env = "DISPLAY=" + display;
+  std::vector<char *> env;
+  for (char **e = environ; *e; e++)
+    if (strncmp(*e, "DISPLAY=", 8) != 0)
+      env.push_back(*e);
+  env.push_back(&display_env[0]);
+  env.push_back(0);
+
+  char *const argv[] = { const_cast<char *>(shell), const_cast<char *>("-c"),
+                         const_cast<char *>(m_cmd.c_str() ), 0 };
+
+  sigset_t no_signals;
+  sigemptyset(&no_signals);
+
+  posix_spawnattr_t attr;
+  posix_spawnattr_init(&attr);
+  posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSID | POSIX_SPAWN_SETSIGMASK);
+  posix_spawnattr_setsigmask(&attr, &no_signals);
+
+  pid_t pid = -1;
+  int err = posix_spawn(&pid, shell, 0, &attr, argv, &env[0]);
+  posix_spawnattr_destroy(&attr);
+
+  if (err != 0) {
+    std::cerr << "shynebox: failed to run '" << m_cmd << "': "
+              << strerror(err) << "\n";
+    return -1;
+  }
+  return pid;
+#else
+  pid_t pid = fork();
+  if (pid)
+    return pid;
+
+  tk::App::setenv("DISPLAY", display.c_str() );
+
   setsid();
   execl(shell, shell, "-c", m_cmd.c_str(), static_cast<void*>(NULL) );
   exit(EXIT_SUCCESS);
 
   return pid; // compiler happy -> we are happy ;)
+#endif // HAVE_POSIX_SPAWN
 #endif // EMX
 } // run
 
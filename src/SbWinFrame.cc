@@ -9,6 +9,7 @@
 #include "IconButton.hh"
 #include "RectangleUtil.hh"
 
+#include "tk/GContext.hh"
 #include "tk/ImageControl.hh"
 #include "tk/LayerItem.hh"
 #include "tk/LayerManager.hh"
@@ -31,6 +32,8 @@ enum { UNFOCUS = 0, FOCUS, PRESSED };
 
 const long s_mask = ButtonPressMask | ButtonReleaseMask | ButtonMotionMask | EnterWindowMask | LeaveWindowMask;
 
+const int s_grip_width = 20; // hardcoded grip width
+
 const struct {
     tk::Orientation orient;
     ContAlignEnum align;
@@ -72,6 +75,19 @@ void bg_pm_or_color(tk::SbWindow& win, const Pixmap& pm, const tk::Color& color)
     win.setBackgroundColor(color);
 }
 
+// ParentRelative leaves what's already there, like it did for a child window
+void fill_pm_or_color(tk::SbPixmap &dest, tk::GContext &gc, const Pixmap& pm,
+                      const tk::Color& color, int x, unsigned int w, unsigned int h) {
+  if (pm == ParentRelative)
+    return;
+  if (pm)
+    dest.copyArea(pm, gc.gc(), 0, 0, x, 0, w, h);
+  else {
+    gc.setForeground(color);
+    dest.fillRectangle(gc.gc(), x, 0, w, h);
+  }
+}
+
 } // end anonymous
 
 SbWinFrame::SbWinFrame(BScreen &screen, int client_depth,
@@ -96,14 +112,6 @@ SbWinFrame::SbWinFrame(BScreen &screen, int client_depth,
         screen.rootWindow().decorationDepth(), InputOutput,
         screen.rootWindow().decorationVisual(),
         screen.rootWindow().decorationColormap() ),
-    m_grip_right(m_handle, 0, 0, 10, 4, s_mask, false, false,
-        screen.rootWindow().decorationDepth(), InputOutput,
-        screen.rootWindow().decorationVisual(),
-        screen.rootWindow().decorationColormap() ),
-    m_grip_left(m_handle, 0, 0, 10, 4, s_mask, false, false,
-        screen.rootWindow().decorationDepth(), InputOutput,
-        screen.rootWindow().decorationVisual(),
-        screen.rootWindow().decorationColormap() ),
     m_clientarea(m_window, 0, 0, 100, 100, s_mask),
     m_bevel(1),
     m_use_titlebar(true),
@@ -363,11 +371,8 @@ void SbWinFrame::clearAll() {
   } else if (m_tabmode == EXTERNAL && m_use_tabs)
     m_tab_container.clear();
 
-  if (m_use_handle) {
+  if (m_use_handle)
     m_handle.clear();
-    m_grip_left.clear();
-    m_grip_right.clear();
-  }
 }
 
 void SbWinFrame::setFocus(bool newvalue) {
@@ -587,8 +592,6 @@ bool SbWinFrame::hideHandle() {
     return false;
 
   m_handle.hide();
-  m_grip_left.hide();
-  m_grip_right.hide();
   m_use_handle = false;
 
   int h = m_window.height();
@@ -614,7 +617,6 @@ bool SbWinFrame::showHandle() {
   applyHandles();
 
   m_handle.show();
-  m_handle.showSubwindows(); // shows grips
 
   m_window.resize(m_window.width(),
       m_window.height() + m_handle.height() +
@@ -630,8 +632,6 @@ void SbWinFrame::setEventHandler(tk::EventHandler &evh) {
   evm.add(evh, m_label);
   evm.add(evh, m_titlebar);
   evm.add(evh, m_handle);
-  evm.add(evh, m_grip_right);
-  evm.add(evh, m_grip_left);
   evm.add(evh, m_window);
 }
 
@@ -642,8 +642,6 @@ void SbWinFrame::removeEventHandler() {
   evm.remove(m_label);
   evm.remove(m_titlebar);
   evm.remove(m_handle);
-  evm.remove(m_grip_right);
-  evm.remove(m_grip_left);
   evm.remove(m_window);
 }
 
@@ -657,10 +655,6 @@ void SbWinFrame::exposeEvent(XExposeEvent &event) {
     win = &m_label;
   else if (m_handle == event.window)
     win = &m_handle;
-  else if (m_grip_left == event.window)
-    win = &m_grip_left;
-  else if (m_grip_right == event.window)
-    win = &m_grip_right;
   else {
     if (m_tab_container.tryExposeEvent(event) )
       return;
@@ -704,8 +698,6 @@ void SbWinFrame::reconfigure() {
                     orig_handle_h + theme()->handleWidth() );
 
   handle().resize(handle().width(), theme()->handleWidth() );
-  gripLeft().resize(buttonHeight(), theme()->handleWidth() );
-  gripRight().resize(gripLeft().width(), gripLeft().height() );
 
   // align titlebar and render it
   if (m_use_titlebar) {
@@ -725,7 +717,7 @@ void SbWinFrame::reconfigure() {
     alignTabs();
   }
 
-  // leave client+grips alone if we're shaded (it'll get fixed when we unshade)
+  // leave client+handle alone if we're shaded (it'll get fixed when we unshade)
   if (!m_state.shaded || m_state.fullscreen) {
     int client_top = 0;
     int client_height = m_window.height();
@@ -736,9 +728,8 @@ void SbWinFrame::reconfigure() {
       client_height -= titlebar_height;
     }
 
-    // align handle and grips
+    // align handle, grips are part of its pixmap
     const int grip_height = m_handle.height();
-    const int grip_width = 20; // hardcoded grip width
     const int handle_bw = static_cast<signed>(m_handle.borderWidth() );
 
     int ypos = m_window.height();
@@ -753,14 +744,6 @@ void SbWinFrame::reconfigure() {
     m_handle.moveResize(-handle_bw, ypos,
                         m_window.width(), grip_height);
 
-    m_grip_left.invalidateBackground();
-    m_grip_left.moveResize(-handle_bw, -handle_bw,
-                           grip_width, grip_height);
-
-    m_grip_right.invalidateBackground();
-    m_grip_right.moveResize(m_handle.width() - grip_width - handle_bw, -handle_bw,
-                            grip_width, grip_height);
-
     if (m_use_handle) {
       m_handle.raise();
       client_height -= m_handle.height() + m_handle.borderWidth();
@@ -990,20 +973,100 @@ void SbWinFrame::renderHandles() {
          uft->handleTexture(), m_imagectrl);
 
   render(m_grip_face.color[FOCUS], m_grip_face.pm[FOCUS],
-         m_grip_left.width(), m_grip_left.height(),
+         s_grip_width, m_handle.height(),
          ft->gripTexture(), m_imagectrl);
 
   render(m_grip_face.color[UNFOCUS], m_grip_face.pm[UNFOCUS],
-         m_grip_left.width(), m_grip_left.height(),
+         s_grip_width, m_handle.height(),
          uft->gripTexture(), m_imagectrl);
+
+  composeHandle(FOCUS, ft->border().color() );
+  composeHandle(UNFOCUS, uft->border().color() );
+}
+
+// The grips used to be child windows of the handle, each with its own
+// background and border. Drawing them into the handle's pixmap keeps the
+// bottom of a frame at one window and one background per focus state.
+// This is the first step towards drawing all decorations into one surface
+// per frame, the titlebar and its buttons are still separate windows.
+void SbWinFrame::composeHandle(int f, const tk::Color &border) {
+  const unsigned int w = m_handle.width(), h = m_handle.height();
+  const unsigned int gw = std::min<unsigned int>(s_grip_width, w / 2);
+  const unsigned int bw = m_handle.borderWidth();
+  tk::SbPixmap &pm = m_handle_pm[f];
+
+  // the frame shows through, there's nothing of ours to draw on.
+  // applyHandles() sets the handle face as is
+  if (m_handle_face.pm[f] == ParentRelative) {
+    pm = None;
+    return;
+  }
+
+  if (pm.drawable() == None || pm.width() != w || pm.height() != h) {
+    pm = None;
+    pm.create(m_handle.window(), w, h, m_handle.depth() );
+  }
+
+  tk::GContext gc(pm);
+  fill_pm_or_color(pm, gc, m_handle_face.pm[f], m_handle_face.color[f],
+                   0, w, h);
+  fill_pm_or_color(pm, gc, m_grip_face.pm[f], m_grip_face.color[f],
+                   0, gw, h);
+  fill_pm_or_color(pm, gc, m_grip_face.pm[f], m_grip_face.color[f],
+                   w - gw, gw, h);
+
+  // inner borders the grip windows had
+  if (bw > 0 && w > 2 * (gw + bw) ) {
+    gc.setForeground(border);
+    pm.fillRectangle(gc.gc(), gw, 0, bw, h);
+    pm.fillRectangle(gc.gc(), w - gw - bw, 0, bw, h);
+  }
 }
 
 void SbWinFrame::applyHandles() {
   bool f = m_state.focused;
 
-  bg_pm_or_color(m_handle, m_handle_face.pm[f], m_handle_face.color[f]);
-  bg_pm_or_color(m_grip_left, m_grip_face.pm[f], m_grip_face.color[f]);
-  bg_pm_or_color(m_grip_right, m_grip_face.pm[f], m_grip_face.color[f]);
+  if (m_handle_pm[f].drawable() )
+    m_handle.setBackgroundPixmap(m_handle_pm[f].drawable() );
+  else
+    bg_pm_or_color(m_handle, m_handle_face.pm[f], m_handle_face.color[f]);
+}
+
+int SbWinFrame::handleZone(int x) const {
+  const int gw = s_grip_width + m_handle.borderWidth();
+  if (x < gw)
+    return Keys::ON_LEFTGRIP;
+  if (x >= static_cast<signed>(m_handle.width() ) - gw)
+    return Keys::ON_RIGHTGRIP;
+  return 0;
+}
+
+// motion is only selected while the pointer is over the handle, the
+// rest of the time moving across handles costs no events
+void SbWinFrame::handleCrossing(bool inside, int x) {
+  if (inside != m_handle_motion) {
+    m_handle_motion = inside;
+    m_handle.setEventMask(inside ? s_mask | PointerMotionMask : s_mask);
+  }
+  if (inside)
+    updateHandleCursor(x);
+}
+
+void SbWinFrame::updateHandleCursor(int x) {
+  Cursor cur = None;
+  switch (handleZone(x) ) {
+  case Keys::ON_LEFTGRIP:
+    cur = theme()->lowerLeftAngleCursor();
+    break;
+  case Keys::ON_RIGHTGRIP:
+    cur = theme()->lowerRightAngleCursor();
+    break;
+  }
+
+  if (cur != m_handle_cursor) {
+    m_handle_cursor = cur;
+    m_handle.setCursor(cur);
+  }
 }
 
 void SbWinFrame::renderButtons() {
@@ -1043,8 +1106,6 @@ void SbWinFrame::init() {
   if (theme()->handleWidth() == 0)
     m_use_handle = false;
 
-  m_handle.showSubwindows();
-
   // clear pixmaps
   m_title_face.pm[UNFOCUS] = m_title_face.pm[FOCUS] = 0;
   m_label_face.pm[UNFOCUS] = m_label_face.pm[FOCUS] = 0;
@@ -1056,6 +1117,7 @@ void SbWinFrame::init() {
   m_button_size = 26; // hardcoded button size
 
   m_label.setBorderWidth(0);
+  m_tab_container.setScrollable(true);
 
   setTabMode(NOTSET);
 
@@ -1069,10 +1131,6 @@ void SbWinFrame::init() {
 
   setEventHandler(*this);
 
-  // setup cursors for resize grips
-  gripLeft().setCursor(theme()->lowerLeftAngleCursor() );
-  gripRight().setCursor(theme()->lowerRightAngleCursor() );
-
   setBorderWidth(true);
 }
 
@@ -1168,8 +1226,6 @@ bool SbWinFrame::setBorderWidth(bool do_move) {
     window().setBorderColor(c);
     titlebar().setBorderColor(c);
     handle().setBorderColor(c);
-    gripLeft().setBorderColor(c);
-    gripRight().setBorderColor(c);
     tabcontainer().setBorderColor(c);
   }
 
@@ -1197,8 +1253,6 @@ bool SbWinFrame::setBorderWidth(bool do_move) {
 
   titlebar().setBorderWidth(border_width);
   handle().setBorderWidth(border_width);
-  gripLeft().setBorderWidth(border_width);
-  gripRight().setBorderWidth(border_width);
 
   if (bw_changes != 0)
     resize(width(), height() + bw_changes);
@@ -1344,16 +1398,12 @@ void SbWinFrame::displaySize(unsigned int width, unsigned int height) const {
   m_screen.showGeometry(i, j);
 }
 
-bool SbWinFrame::insideTitlebar(Window win) const {
-  return gripLeft().window() != win
-         && gripRight().window() != win
-         && window().window() != win;
-}
-
 int SbWinFrame::getContext(Window win, int x, int y, int last_x, int last_y, bool doBorders) {
   int context = 0;
-  if (gripLeft().window()  == win) return Keys::ON_LEFTGRIP;
-  if (gripRight().window() == win) return Keys::ON_RIGHTGRIP;
+  if (handle().window()    == win) {
+    const int zone = handleZone(x - this->x() - window().borderWidth() );
+    return zone ? zone : Keys::ON_WINDOWBORDER | Keys::ON_WINDOW;
+  }
   if (doBorders) {
     using RectangleUtil::insideBorder;
     int borderw = window().borderWidth();
@@ -1369,12 +1419,6 @@ int SbWinFrame::getContext(Window win, int x, int y, int last_x, int last_y, boo
 
   if (window().window()    == win)
     return context | Keys::ON_WINDOW;
-  if (handle().window()    == win) {
-    const unsigned int px = x - this->x() - window().borderWidth();
-    if (px < gripLeft().x() + gripLeft().width() || px > (unsigned)gripRight().x() )
-      return context; // one of the corners
-    return Keys::ON_WINDOWBORDER | Keys::ON_WINDOW;
-  }
   if (titlebar().window()  == win) {
     const unsigned int px = x - this->x() - window().borderWidth();
     if (px < (unsigned)label().x() || px > label().x() + label().width() )
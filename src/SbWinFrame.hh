@@ -16,6 +16,7 @@
 #include "tk/Color.hh"
 #include "tk/TextButton.hh"
 #include "tk/ButtonTrain.hh"
+#include "tk/SbPixmap.hh"
 #include "tk/Timer.hh"
 
 #include <vector>
@@ -83,6 +84,7 @@ public:
   void removeAllButtons();
   void createTab(tk::Button &button);
   void removeTab(IconButton *id);
+  void showTab(const tk::Button &btn) { m_tab_container.showItem(&btn); }
   void moveLabelButtonLeft(tk::TextButton &btn);
   void moveLabelButtonRight(tk::TextButton &btn);
   void moveLabelButtonLeftOf(tk::TextButton &btn, const tk::TextButton &dest);
@@ -152,10 +154,6 @@ public:
   tk::SbWindow &clientArea() { return m_clientarea; }
   const tk::SbWindow &handle() const { return m_handle; }
   tk::SbWindow &handle() { return m_handle; }
-  const tk::SbWindow &gripLeft() const { return m_grip_left; }
-  tk::SbWindow &gripLeft() { return m_grip_left; }
-  const tk::SbWindow &gripRight() const { return m_grip_right; }
-  tk::SbWindow &gripRight() { return m_grip_right; }
   bool focused() const { return m_state.focused; }
   FocusableTheme<SbWinFrameTheme> &theme() const { return m_theme; }
   unsigned int titlebarHeight() const { return (m_use_titlebar?m_titlebar.height()+m_titlebar.borderWidth():0); }
@@ -166,7 +164,9 @@ public:
   const tk::LayerItem &layerItem() const { return *m_layeritem; }
   tk::LayerItem &layerItem() { return *m_layeritem; }
 
-  bool insideTitlebar(Window win) const;
+  // grips are painted into the handle, x is relative to the handle
+  void handleCrossing(bool inside, int x);
+  void updateHandleCursor(int x);
 
   // context of 'keys' actions: titlebar, border, window, etc
   int getContext(Window win, int x=0, int y=0, int last_x=0, int last_y=0, bool doBorders=false);
@@ -205,6 +205,11 @@ private:
   void applyButton(tk::Button &btn);
   void alignTabs();
 
+  // Keys::ON_LEFTGRIP, ON_RIGHTGRIP or 0 for the middle of the handle
+  int handleZone(int x) const;
+  // paint handle, grips and grip borders into m_handle_pm
+  void composeHandle(int f, const tk::Color &border);
+
   // initiate some common variables and themes
   void init();
 
@@ -222,9 +227,7 @@ private:
   tk::SbWindow    m_titlebar;      // titlebar
   tk::ButtonTrain m_tab_container; // holds tabs
   tk::TextButton  m_label;         // holds title if tabs are external
-  tk::SbWindow    m_handle;        // handle between grips
-  tk::SbWindow    m_grip_right,    // right grip
-                  m_grip_left;     // left grip
+  tk::SbWindow    m_handle;        // handle, grips are drawn on its ends
   tk::SbWindow    m_clientarea;    // where the client window sits inside the frame
 
   typedef std::vector<tk::Button *> ButtonList;
@@ -250,6 +253,10 @@ private:
   Face m_grip_face;
   BtnFace m_button_face;
 
+  tk::SbPixmap m_handle_pm[2]; // handle with grips, 0-unfocus, 1-focus
+  Cursor m_handle_cursor = None;
+  bool m_handle_motion = false; // PointerMotionMask selected on the handle
+
   TabMode m_tabmode;
 
   unsigned int m_active_orig_client_bw;
@@ -143,11 +143,12 @@ BScreen::BScreen(tk::ConfigManager &cm,
       m_pos_window(new OSDWindow(m_root_window, *this, *m_focused_windowtheme) ),
       m_tooltip_window(new TooltipWindow(m_root_window, *this, *m_focused_windowtheme) ),
       m_cfgmap(cm.get_cfgmap() ),
-      m_workspace_cnt(*m_cfgmap["workspaces"]),
-      m_menu_delay(*m_cfgmap["menuDelay"]),
-      m_tooltip_delay(*m_cfgmap["tooltipDelay"]),
-      m_titlebar_left_str(*m_cfgmap["titlebar.left"]),
-      m_titlebar_right_str(*m_cfgmap["titlebar.right"]),
+      m_cfg(cm),
+      m_workspace_cnt(*m_cfg[tk::CFG_WORKSPACES]),
+      m_menu_delay(*m_cfg[tk::CFG_MENU_DELAY]),
+      m_tooltip_delay(*m_cfg[tk::CFG_TOOLTIP_DELAY]),
+      m_titlebar_left_str(*m_cfg[tk::CFG_TITLEBAR_LEFT]),
+      m_titlebar_right_str(*m_cfg[tk::CFG_TITLEBAR_RIGHT]),
       m_focus_control(new FocusControl(*this) ),
       m_placement_strategy(new ScreenPlacement(*this) ),
       m_opts(opts) {
@@ -251,7 +252,7 @@ BScreen::BScreen(tk::ConfigManager &cm,
   rootWindow().setCursor(XCreateFontCursor(disp, XC_left_ptr) );
 
   // initialize workspace names from config
-  string cfg_names = *m_cfgmap["workspaceNames"];
+  string cfg_names = *m_cfg[tk::CFG_WORKSPACE_NAMES];
   BScreen::WorkspaceNames names;
   tk::StringUtil::stringtok<BScreen::WorkspaceNames>(names, cfg_names, ",");
 
@@ -608,7 +609,7 @@ void BScreen::updateWorkspaceName(unsigned int w) {
       string new_names = "";
       for (auto n : m_workspace_names)
         new_names += n + ",";
-      *m_cfgmap["workspaceNames"] = new_names;
+      *m_cfg[tk::CFG_WORKSPACE_NAMES] = new_names;
       Shynebox::instance()->save_rc();
     }
 
@@ -743,10 +744,17 @@ void BScreen::changeWorkspaceID(unsigned int id, bool revert) {
   tk::App::instance()->sync(false);
   Shynebox::instance()->grab();
 
+  // the switch is one batch. maps/unmaps go out under a single grab,
+  // focus changes in between don't touch EWMH or the toolbar. those are
+  // published once at the end. stacking is untouched, the layers keep
+  // every frame in order whether it's mapped or not
+  m_changing_ws = true;
+
   ShyneboxWindow *focused = FocusControl::focusedSbWindow();
+  const bool carry = focused && focused->isMoving() && doOpaqueMove();
 
   // don't reassociate if not opaque moving
-  if (focused && focused->isMoving() && doOpaqueMove() )
+  if (carry)
     reassociateWindow(focused, id, true);
 
   // set new workspace
@@ -754,32 +762,39 @@ void BScreen::changeWorkspaceID(unsigned int id, bool revert) {
   m_current_workspace = getWorkspace(id);
   m_current_wsid = id;
 
+  // sort the old workspace before anything moves around
+  // stuck windows come along, the rest gets hidden
+  vector<ShyneboxWindow *> stuck, hide;
+  for (auto it : old->windowList() )
+    (it->isStuck() ? stuck : hide).push_back(it);
+
   // we show new workspace first in order to appear faster
   currentWorkspace()->showAll();
 
-  // reassociate all windows that are stuck to the new workspace
-  Workspace::Windows wins = old->windowList(); // specifies type for 'auto'
-  for (auto it : wins)
-    if (it->isStuck() )
-      reassociateWindow(it, id, true);
+  for (auto it : stuck)
+    reassociateWindow(it, id, true);
 
   // change workspace ID of stuck iconified windows, too
   for (auto it : iconList() )
     if (it->isStuck() ) {
-      getWorkspace(id)->addWindow(*it);
+      currentWorkspace()->addWindow(*it);
       it->setWorkspace(id);
     }
 
-  if (focused && focused->isMoving() && doOpaqueMove() )
+  if (carry)
     focused->focus();
   else if (revert)
     FocusControl::revertFocus(*this);
 
-  old->hideAll(false);
+  for (auto it : hide)
+    it->hide(false);
+
+  m_changing_ws = false;
 
   Shynebox::instance()->ungrab();
   tk::App::instance()->sync(false);
 
+  focusControl().workspaceChanged(); // filtered lists on [current]
 #if USE_TOOLBAR
   resetToolbar();
 #endif
@@ -901,8 +916,12 @@ void BScreen::cycleFocus(int options, const ClientPattern *pat, bool reverse) {
   if (mods == 0) // can't stacked cycle unless there is a mod to grab
     options |= FocusableList::STATIC_ORDER;
 
-  const FocusableList *win_list =
-      FocusableList::getListFromOptions(*this, options);
+  // patterns get a list of their own that follows window changes,
+  // so cycling only walks windows that match
+  const FocusableList *win_list = pat ?
+      focusControl().filteredList(options, *pat) : 0;
+  if (!win_list)
+    win_list = FocusableList::getListFromOptions(*this, options);
   focusControl().cycleFocus(*win_list, pat, reverse);
 #if USE_TOOLBAR
   updateToolbar(false);
@@ -947,6 +966,9 @@ void BScreen::reconfigure() {
 } // reconfigure
 
 void BScreen::reconfigThemes() {
+  // icon sizes follow the style
+  imageControl().iconCache().clear();
+
   focusedWinFrameTheme()->reconfigTheme();
   unfocusedWinFrameTheme()->reconfigTheme();
   menuTheme()->reconfigTheme();
@@ -1276,9 +1298,11 @@ void BScreen::updateIconbar() {
 void BScreen::updateToolbar(bool everything) { // true
   if (!m_toolbar)
     return;
-  if (everything) // aka not just iconbar
-    m_toolbar->relayout();
-  else if (m_toolbar->m_tool_factory.hasSystray() )
+  if (everything) { // aka not just iconbar
+    m_toolbar->relayout(); // does ALIGN after the layout
+    return;
+  }
+  if (m_toolbar->m_tool_factory.hasSystray() )
     m_toolbar->m_tool_factory.m_sys_tray->updateSizing();
   m_toolbar->m_tool_factory.updateIconbar(0); // ALIGN
 }
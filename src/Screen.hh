@@ -70,38 +70,40 @@ public:
   ~BScreen();
 
   bool isShuttingdown() const { return m_state.shutdown; }
+  // EWMH/toolbar updates wait until the switch is done
+  bool isChangingWorkspace() const { return m_changing_ws; }
   bool isRestart();
   void shutdown();
   void initWindows();
 
   // config items
-  bool isWorkspaceWarpingHorizontal() const { return *m_cfgmap["workspaceWarpingHorizontal"]; }
-  bool isWorkspaceWarpingVertical() const { return *m_cfgmap["workspaceWarpingVertical"]; }
-  bool doAutoRaise() const { return *m_cfgmap["autoRaiseWindows"]; }
-  bool clickRaisesWindows() const { return *m_cfgmap["clickRaisesWindows"]; }
-  bool doOpaqueMove() const { return *m_cfgmap["opaqueMove"]; }
-  bool doOpaqueResize() const { return *m_cfgmap["opaqueResize"]; }
-  bool doFullMax() const { return *m_cfgmap["fullMaximization"]; }
-  bool getMaxIgnoreIncrement() const { return *m_cfgmap["maxIgnoreIncrement"]; }
-  bool getMaxDisableMove() const { return *m_cfgmap["maxDisableMove"]; }
-  bool getMaxDisableResize() const { return *m_cfgmap["maxDisableResize"]; }
-  bool doShowWindowPos() const { return *m_cfgmap["showWindowPosition"]; }
-  bool clientMenuUsePixmap() const { return *m_cfgmap["clientMenu.usePixmap"]; }
-  bool getDefaultInternalTabs() const { return *m_cfgmap["tabs.inTitlebar"]; }
-  bool getTabsUsePixmap() const { return *m_cfgmap["tabs.usePixmap"]; }
-  bool getMaxOverTabs() const { return *m_cfgmap["tabs.maxOver"]; }
-  bool doObeyHeads() const { return *m_cfgmap["obeyHeads"]; }
-  const string &defaultDeco() const { return *m_cfgmap["defaultDeco"]; }
-  unsigned int opaqueResizeDelay() const { return *m_cfgmap["opaqueResizeDelay"]; }
-  unsigned int getTabWidth() const { return *m_cfgmap["tabs.width"]; }
-  unsigned int noFocusWhileTypingDelay() const { return *m_cfgmap["noFocusWhileTypingDelay"]; }
-  int getEdgeSnapThreshold() const { return *m_cfgmap["edgeSnapThreshold"]; }
-  int getEdgeResizeSnapThreshold() const { return *m_cfgmap["edgeResizeSnapThreshold"]; }
-  int getWorkspaceWarpingHorizontalOffset() const { return *m_cfgmap["workspaceWarpingHorizontalOffset"]; }
-  int getWorkspaceWarpingVerticalOffset() const { return *m_cfgmap["workspaceWarpingVerticalOffset"]; }
-  tk::TabPlacement_e getTabPlacement() const { return (tk::TabPlacement_e)(int)((tk::strnum)*m_cfgmap["tabs.placement"]); }
-  void saveTabPlacement(tk::TabPlacement_e place) { (tk::strnum&)(*m_cfgmap["tabs.placement"]) = (int)place; }
-  void updateActiveWorkspaceCount(int w) { *m_cfgmap["workspaces"] = w; }
+  bool isWorkspaceWarpingHorizontal() const { return *m_cfg[tk::CFG_WORKSPACE_WARPING_HORIZONTAL]; }
+  bool isWorkspaceWarpingVertical() const { return *m_cfg[tk::CFG_WORKSPACE_WARPING_VERTICAL]; }
+  bool doAutoRaise() const { return *m_cfg[tk::CFG_AUTO_RAISE_WINDOWS]; }
+  bool clickRaisesWindows() const { return *m_cfg[tk::CFG_CLICK_RAISES_WINDOWS]; }
+  bool doOpaqueMove() const { return *m_cfg[tk::CFG_OPAQUE_MOVE]; }
+  bool doOpaqueResize() const { return *m_cfg[tk::CFG_OPAQUE_RESIZE]; }
+  bool doFullMax() const { return *m_cfg[tk::CFG_FULL_MAXIMIZATION]; }
+  bool getMaxIgnoreIncrement() const { return *m_cfg[tk::CFG_MAX_IGNORE_INCREMENT]; }
+  bool getMaxDisableMove() const { return *m_cfg[tk::CFG_MAX_DISABLE_MOVE]; }
+  bool getMaxDisableResize() const { return *m_cfg[tk::CFG_MAX_DISABLE_RESIZE]; }
+  bool doShowWindowPos() const { return *m_cfg[tk::CFG_SHOW_WINDOW_POSITION]; }
+  bool clientMenuUsePixmap() const { return *m_cfg[tk::CFG_CLIENT_MENU_USE_PIXMAP]; }
+  bool getDefaultInternalTabs() const { return *m_cfg[tk::CFG_TABS_IN_TITLEBAR]; }
+  bool getTabsUsePixmap() const { return *m_cfg[tk::CFG_TABS_USE_PIXMAP]; }
+  bool getMaxOverTabs() const { return *m_cfg[tk::CFG_TABS_MAX_OVER]; }
+  bool doObeyHeads() const { return *m_cfg[tk::CFG_OBEY_HEADS]; }
+  const string &defaultDeco() const { return *m_cfg[tk::CFG_DEFAULT_DECO]; }
+  unsigned int opaqueResizeDelay() const { return *m_cfg[tk::CFG_OPAQUE_RESIZE_DELAY]; }
+  unsigned int getTabWidth() const { return *m_cfg[tk::CFG_TABS_WIDTH]; }
+  unsigned int noFocusWhileTypingDelay() const { return *m_cfg[tk::CFG_NO_FOCUS_WHILE_TYPING_DELAY]; }
+  int getEdgeSnapThreshold() const { return *m_cfg[tk::CFG_EDGE_SNAP_THRESHOLD]; }
+  int getEdgeResizeSnapThreshold() const { return *m_cfg[tk::CFG_EDGE_RESIZE_SNAP_THRESHOLD]; }
+  int getWorkspaceWarpingHorizontalOffset() const { return *m_cfg[tk::CFG_WORKSPACE_WARPING_HORIZONTAL_OFFSET]; }
+  int getWorkspaceWarpingVerticalOffset() const { return *m_cfg[tk::CFG_WORKSPACE_WARPING_VERTICAL_OFFSET]; }
+  tk::TabPlacement_e getTabPlacement() const { return (tk::TabPlacement_e)(int)((tk::strnum)*m_cfg[tk::CFG_TABS_PLACEMENT]); }
+  void saveTabPlacement(tk::TabPlacement_e place) { (tk::strnum&)(*m_cfg[tk::CFG_TABS_PLACEMENT]) = (int)place; }
+  void updateActiveWorkspaceCount(int w) { *m_cfg[tk::CFG_WORKSPACES] = w; }
 
   // related to cfg for titlebar, but getters for private vars
   vector<WinButton::Type> &titlebar_left() { return m_titlebar_left; }
@@ -307,12 +309,14 @@ public:
                    int w = 0, int h = 0, int bw = 0,
                    bool respect_struts = false) const;
 
-  tk::CFGMAP &m_cfgmap;
+  tk::CFGMAP &m_cfgmap; // for per screen keys like struts
+  tk::ConfigManager &m_cfg;
 
 private:
   tk::Timer m_cycle_timer,
             m_bg_timer;
   bool m_cycle_lock = false;
+  bool m_changing_ws = false;
   void reconfigBGTimer() { m_root_theme->reconfigTheme(); }
   void unlockCycleTimer() { m_cycle_lock = false; }
 
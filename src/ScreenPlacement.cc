@@ -26,9 +26,9 @@
 #define COLDIR tk::ColDirection_e
 
 ScreenPlacement::ScreenPlacement(BScreen &screen):
-    m_row_direction((ROWDIR&)((int&)(*screen.m_cfgmap["rowPlacementDirection"]) ) ),
-    m_col_direction((COLDIR&)((int&)(*screen.m_cfgmap["colPlacementDirection"]) ) ),
-    m_placement_policy((SPP&)((int&)(*screen.m_cfgmap["windowPlacement"]) ) ),
+    m_row_direction((ROWDIR&)((int&)(*screen.m_cfg[tk::CFG_ROW_PLACEMENT_DIRECTION]) ) ),
+    m_col_direction((COLDIR&)((int&)(*screen.m_cfg[tk::CFG_COL_PLACEMENT_DIRECTION]) ) ),
+    m_placement_policy((SPP&)((int&)(*screen.m_cfg[tk::CFG_WINDOW_PLACEMENT]) ) ),
     m_old_policy(SPP::ROWSMARTPLACEMENT),
     m_screen(screen)
 { } // ScreenPlacement class init
@@ -24,30 +24,14 @@ using std::dec;
 
 namespace {
 
-void getScreenCoordinates(Window win, int x, int y, int &screen_x, int &screen_y) {
-  XWindowAttributes attr;
-  if (XGetWindowAttributes(tk::App::instance()->display(), win, &attr) == 0)
-    return;
-
-  Window unused_win;
-  Window parent_win;
-  Window root_win = 0;
-  Window* unused_childs = 0;
-  unsigned int unused_number;
-
-  XQueryTree(tk::App::instance()->display(), win,
-             &root_win,
-             &parent_win,
-             &unused_childs, &unused_number);
-
-  if (unused_childs != 0)
-    XFree(unused_childs);
-
-  XTranslateCoordinates(tk::App::instance()->display(),
-                        parent_win, root_win,
-                        x, y,
-                        &screen_x, &screen_y, &unused_win);
-} // getScreenCoordinates
+// root position of x,y inside win, from the geometry we already track
+// instead of asking the server
+void rootCoordinates(const tk::SbWindow &win, int &x, int &y) {
+  for (const tk::SbWindow *w = &win; w != 0; w = w->parent() ) {
+    x += w->x() + w->borderWidth();
+    y += w->y() + w->borderWidth();
+  }
+} // rootCoordinates
 
 };
 
@@ -98,11 +82,29 @@ public:
     return true;
   }
 
+  // moves the icon, and tells it where that is on screen. both only
+  // when something changed, a relayout usually leaves most icons alone
+  void place(int x, int y, unsigned int size, int root_x, int root_y) {
+    moveResize(x, y, size, size);
+    if (root_x != m_root_x || root_y != m_root_y || size != m_sent_size)
+      notify(root_x, root_y, size);
+  }
+
+  void notify(int root_x, int root_y, unsigned int size) {
+    m_root_x = root_x;
+    m_root_y = root_y;
+    m_sent_size = size;
+    sendConfigureNotify(root_x, root_y, size, size);
+  }
+
   int m_order = 0; // see pinByClassname(), -2, 0, 1, 4
 
 private:
   bool m_visible;
   bool m_xembedded; // using xembed protocol? (i.e. unmap when done)
+  // last synthetic ConfigureNotify
+  int m_root_x = 0, m_root_y = 0;
+  unsigned int m_sent_size = 0;
 }; // SystemTray TrayWindow
 
 // orders the tray list by crawling pin lists
@@ -153,8 +155,8 @@ SystemTray::SystemTray(const tk::SbWindow& parent,
       m_pixmap(0), m_num_visible_clients(0),
       m_selection_owner(m_window, 0, 0, 1, 1, SubstructureNotifyMask, false, false,
                         CopyFromParent, InputOnly),
-      m_rc_systray_pinleft(*screen.m_cfgmap["systray.pinLeft"]),
-      m_rc_systray_pinright(*screen.m_cfgmap["systray.pinRight"]) {
+      m_rc_systray_pinleft(*screen.m_cfg[tk::CFG_SYSTRAY_PIN_LEFT]),
+      m_rc_systray_pinright(*screen.m_cfg[tk::CFG_SYSTRAY_PIN_RIGHT]) {
   tk::StringUtil::stringtok(m_pinleft, m_rc_systray_pinleft, " ,");
   tk::StringUtil::stringtok(m_pinright, m_rc_systray_pinright, " ,");
 
@@ -351,7 +353,12 @@ void SystemTray::addClient(Window win, bool using_xembed) {
 
   sbdbg<<"SystemTray::addClient(Window): 0x"<<hex<<win<<dec<<"\n";
 
-  m_clients.push_back(traywin);
+  // after the ones with the same order, like a stable sort would
+  traywin->pinByClassname(m_pinleft, m_pinright);
+  it = m_clients.begin();
+  while (it != m_clients.end() && (*it)->m_order <= traywin->m_order)
+    ++it;
+  m_clients.insert(it, traywin);
   tk::EventManager::instance()->add(*this, win);
   traywin->reparent(m_window, 0, 0);
   traywin->addToSaveSet();
@@ -377,11 +384,6 @@ void SystemTray::addClient(Window win, bool using_xembed) {
 
   if (traywin->getMappedDefault() )
     showClient(traywin);
-
-  traywin->pinByClassname(m_pinleft, m_pinright);
-  m_clients.sort( [](TrayWindow *a, TrayWindow *b)
-    { return a->m_order < b->m_order; } );
-  rearrangeClients();
 } // addClient
 
 void SystemTray::removeClient(Window win, bool destroyed) {
@@ -435,7 +437,9 @@ void SystemTray::handleEvent(XEvent &event) {
 
         // this was why gaim wasn't centring the icon
         // 2023, pidgin and discord both do this
-        (*it)->sendConfigureNotify(0, 0, (*it)->width(), (*it)->height() );
+        int root_x = (*it)->x(), root_y = (*it)->y();
+        rootCoordinates(m_window, root_x, root_y);
+        (*it)->notify(root_x, root_y, (*it)->width() );
         m_screen.updateToolbar();
       }
     }
@@ -459,8 +463,11 @@ void SystemTray::rearrangeClients() {
   tk::translateSize(orientation(), w_rot0, h_rot0);
   unsigned int trayw = m_num_visible_clients*h_rot0 + bw, trayh = h_rot0;
   tk::translateSize(orientation(), trayw, trayh);
-  resize(trayw, trayh);
-  update();
+  // the background only needs rendering again for a new size
+  if (trayw != m_window.width() || trayh != m_window.height() ) {
+    resize(trayw, trayh);
+    update();
+  }
 
   // move and resize clients
   int next_x = bw;
@@ -473,11 +480,10 @@ void SystemTray::rearrangeClients() {
     next_x += h_rot0+bw;
     translateCoords(orientation(), x, y, w_rot0, h_rot0);
     translatePosition(orientation(), x, y, h_rot0, h_rot0, 0);
-    int screen_x = 0, screen_y = 0;
-    getScreenCoordinates(client_it->window(), client_it->x(), client_it->y(), screen_x, screen_y);
+    int root_x = x, root_y = y;
+    rootCoordinates(m_window, root_x, root_y);
 
-    client_it->moveResize(x, y, h_rot0, h_rot0);
-    client_it->sendConfigureNotify(screen_x, screen_y, h_rot0, h_rot0);
+    client_it->place(x, y, h_rot0, root_x, root_y);
   }
 } // rearrangeClients
 
@@ -130,16 +130,16 @@ Toolbar::Toolbar(BScreen &scrn, tk::Layer &layer, size_t width):
       m_theme(scrn.screenNumber() ),
       m_tool_factory(scrn),
       m_strut(0),
-      m_rc_auto_hide(*scrn.m_cfgmap["toolbar.autoHide"]),
-      m_rc_auto_raise(*scrn.m_cfgmap["toolbar.autoRaise"]),
-      m_rc_claim_space(*scrn.m_cfgmap["toolbar.claimSpace"]),
-      m_rc_visible(*scrn.m_cfgmap["toolbar.visible"]),
-      m_rc_width_percent(*scrn.m_cfgmap["toolbar.widthPercent"]),
-      m_rc_on_head(*scrn.m_cfgmap["toolbar.onHead"]),
-      m_rc_height(*scrn.m_cfgmap["toolbar.height"]),
-      m_rc_layernum((tk::ResLayers_e&)(int&)(*scrn.m_cfgmap["toolbar.layer"]) ),
-      m_rc_placement((TBPLC&)(int&)(*scrn.m_cfgmap["toolbar.placement"]) ),
-      m_rc_tools(*scrn.m_cfgmap["toolbar.tools"]),
+      m_rc_auto_hide(*scrn.m_cfg[tk::CFG_TOOLBAR_AUTO_HIDE]),
+      m_rc_auto_raise(*scrn.m_cfg[tk::CFG_TOOLBAR_AUTO_RAISE]),
+      m_rc_claim_space(*scrn.m_cfg[tk::CFG_TOOLBAR_CLAIM_SPACE]),
+      m_rc_visible(*scrn.m_cfg[tk::CFG_TOOLBAR_VISIBLE]),
+      m_rc_width_percent(*scrn.m_cfg[tk::CFG_TOOLBAR_WIDTH_PERCENT]),
+      m_rc_on_head(*scrn.m_cfg[tk::CFG_TOOLBAR_ON_HEAD]),
+      m_rc_height(*scrn.m_cfg[tk::CFG_TOOLBAR_HEIGHT]),
+      m_rc_layernum((tk::ResLayers_e&)(int&)(*scrn.m_cfg[tk::CFG_TOOLBAR_LAYER]) ),
+      m_rc_placement((TBPLC&)(int&)(*scrn.m_cfg[tk::CFG_TOOLBAR_PLACEMENT]) ),
+      m_rc_tools(*scrn.m_cfg[tk::CFG_TOOLBAR_TOOLS]),
       m_shape(new tk::Shape(frame.window, 0) ) {
   _SB_USES_NLS;
 
@@ -174,6 +174,11 @@ Toolbar::Toolbar(BScreen &scrn, tk::Layer &layer, size_t width):
   m_hide_timer.setCommand(*ucs);
   m_hide_timer.fireOnce(true);
 
+  // no timeout, runs once the queued events are handled
+  tk::SimpleCommand<Toolbar> *rls(new tk::SimpleCommand<Toolbar>(*this, &Toolbar::doRelayout) );
+  m_relayout_timer.setCommand(*rls);
+  m_relayout_timer.fireOnce(true);
+
   // show all windows
   frame.window.showSubwindows();
 
@@ -268,11 +273,21 @@ void Toolbar::lower() {
   m_layeritem.lower();
 }
 
+// tools ask for this whenever their size might have changed, and a
+// systray or iconbar update can ask several times per event batch
 void Toolbar::relayout() {
+  m_relayout_timer.start();
+}
+
+void Toolbar::doRelayout() {
   for (auto it : m_item_list)
     it->updateSizing();
 
   rearrangeItems();
+  m_relayout_all = false;
+
+  // iconbar gets its max sizes from the new width
+  m_tool_factory.updateIconbar(0); // ALIGN
 }
 
 void Toolbar::reconfigure() {
@@ -327,7 +342,6 @@ void Toolbar::reconfigure() {
   } else if (m_theme.shape() && m_shape == 0)
     m_shape = new tk::Shape(frame.window, 0);
 
-  const int old_w = frame.width, old_h = frame.height;
   setPlacement(placement() ); // recalibrate size
 
   // inlines virtual 'moveResize' in psuedo frame.window
@@ -343,8 +357,9 @@ void Toolbar::reconfigure() {
 
   // for head changes and style reloads
   // (fixes lazy systray resize by height)
-  if (old_w != frm_width || old_h != frm_height)
-    relayout();
+  // theme may have changed too, so every item gets rendered again
+  m_relayout_all = true;
+  relayout();
 
   // render frame window
   Pixmap tmp = m_window_pm;
@@ -730,16 +745,25 @@ void Toolbar::rearrangeItems() {
   last_bw = 0;
   int it_bw, offset, size_offset, tmpx, tmpy;
 
+  bool changed = false;
+
   for (auto &item_it : m_item_list) {
     it_bw = item_it->borderWidth();
+    ItemGeometry &geom = m_item_geom[item_it]; // zeroed for new items
     if (!item_it->active() ) {
-      item_it->hide();
       // make sure it still gets told the toolbar height
       tmpw = 1; tmph = height - 2*(bevel_width+it_bw);
       if (tmph >= (1<<30) )
         tmph = 1;
       tk::translateSize(orient, tmpw, tmph);
-      item_it->resize(tmpw, tmph);  // width of 0 changes to 1 anyway
+      if (m_relayout_all || geom.shown
+          || geom.width != tmpw || geom.height != tmph
+          || item_it->width() != tmpw || item_it->height() != tmph) {
+        item_it->hide();
+        item_it->resize(tmpw, tmph);  // width of 0 changes to 1 anyway
+        geom = { 0, 0, tmpw, tmph, false };
+        changed = true;
+      }
       continue;
     }
     offset = bevel_width;
@@ -777,9 +801,22 @@ void Toolbar::rearrangeItems() {
     tk::translateCoords(orient, tmpx, tmpy, width, height);
     tk::translatePosition(orient, tmpx, tmpy, tmpw, tmph, it_bw);
     tk::translateSize(orient, tmpw, tmph);
+
+    // tools render again on moveResize, skip the ones that stay put.
+    // updateSizing() may have resized one behind our back (button tools
+    // shrink to their font), so the live size has to match too
+    if (!m_relayout_all && geom.shown && geom.x == tmpx && geom.y == tmpy
+        && geom.width == tmpw && geom.height == tmph
+        && item_it->width() == tmpw && item_it->height() == tmph)
+      continue;
+
     item_it->moveResize(tmpx, tmpy, tmpw, tmph);
+    geom = { tmpx, tmpy, tmpw, tmph, true };
+    changed = true;
   } // for m_item_list
-  frame.window.clear();
+
+  if (changed)
+    frame.window.clear();
 } // rearrangeItems
 
 void Toolbar::deleteItems() {
@@ -787,6 +824,7 @@ void Toolbar::deleteItems() {
     delete m_item_list.back();
     m_item_list.pop_back();
   }
+  m_item_geom.clear();
   m_tools.clear();
 }
 
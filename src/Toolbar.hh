@@ -28,6 +28,8 @@
 #include "tk/EventHandler.hh"
 #include "tk/SbWindow.hh"
 
+#include <map>
+
 class BScreen;
 class Strut;
 class SbMenu;
@@ -59,6 +61,7 @@ public:
   void leaveNotifyEvent(XCrossingEvent &ce);
   void exposeEvent(XExposeEvent &ee);
 
+  // marks the layout dirty, it is redone once at the end of the event batch
   void relayout();
   void reconfigure();
   void setPlacement(tk::ToolbarPlacement_e where);
@@ -101,6 +104,7 @@ private:
   void updateStrut();
 
   void updateCrossingState();
+  void doRelayout();
 
   bool m_hidden;
 
@@ -120,6 +124,8 @@ private:
   BScreen &m_screen; // screen connection
 
   tk::Timer m_hide_timer; // timer to for auto hide toolbar
+  tk::Timer m_relayout_timer; // collects relayout() calls
+  bool m_relayout_all = false; // move and render items even if unchanged
 
   tk::LayerItem m_layeritem; // layer item, must be declared before layermenu
   LayerMenu m_layermenu;
@@ -131,6 +137,14 @@ private:
   typedef std::list<ToolbarItem *> ItemList;
   ItemList m_item_list;
 
+  // geometry each item was last laid out at
+  struct ItemGeometry {
+    int x, y;
+    unsigned int width, height;
+    bool shown;
+  };
+  std::map<ToolbarItem *, ItemGeometry> m_item_geom;
+
   Strut *m_strut; // created and destroyed by BScreen
 
   // config items
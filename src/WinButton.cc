@@ -10,6 +10,7 @@
 #include "WinButtonTheme.hh"
 #include "tk/Color.hh"
 #include "tk/Command.hh"
+#include "tk/ImageControl.hh"
 
 #ifdef SHAPE
 #include <X11/extensions/shape.h>
@@ -24,7 +25,6 @@ WinButton::WinButton(ShyneboxWindow &listen_to,
       tk::Button(parent, x, y, width, height),
       m_type(buttontype), m_listen_to(listen_to),
       m_theme(theme), m_pressed_theme(pressed),
-      m_icon_pixmap(0), m_icon_mask(0),
       overrode_bg(false), overrode_pressed(false) {
   if (buttontype == MENUICON)
     updateAll();
@@ -126,7 +126,7 @@ Pixmap WinButton::getPixmap(const tk::ThemeProxy<WinButtonTheme> &theme) const {
     else
       return theme->shadePixmap().pixmap().drawable();
   case MENUICON:
-    if (m_icon_pixmap.drawable() )
+    if (scaledIcon() )
       return theme->titlePixmap().pixmap().drawable();
     else
       return theme->menuiconPixmap().pixmap().drawable();
@@ -135,6 +135,19 @@ Pixmap WinButton::getPixmap(const tk::ThemeProxy<WinButtonTheme> &theme) const {
   }
 }
 
+// looked up on every draw, the cache drops it when the icon changes
+const tk::PixmapWithMask *WinButton::scaledIcon() const {
+  int w = static_cast<int>(width() ) - 4;
+  int h = static_cast<int>(height() ) - 4;
+  if (w <= 0 || h <= 0 || m_listen_to.empty() )
+    return 0;
+
+  BScreen &screen = m_listen_to.screen();
+  tk::IconCache &cache = screen.imageControl().iconCache();
+  return cache.scaled(m_listen_to.icon(), w, h,
+                      DefaultDepth(display(), screen.screenNumber() ) );
+}
+
 // clear is used to force this to clear the window (e.g. called from clear() )
 void WinButton::drawType() {
   int w = width();
@@ -142,8 +155,9 @@ void WinButton::drawType() {
   int oddW = w % 2; // if it's odd and we're centring, we need to add one
   int oddH = h % 2;
   bool is_pressed = pressed();
+  const tk::PixmapWithMask *icon = m_type == MENUICON ? scaledIcon() : 0;
 
-  if ((!m_icon_pixmap.drawable()
+  if ((!icon
         && ((is_pressed && overrode_pressed)
           || (!is_pressed && overrode_bg) ) )
       || gc() == 0)
@@ -195,19 +209,19 @@ void WinButton::drawType() {
     break;
   }
   case MENUICON:
-    if (m_icon_pixmap.drawable() ) {
+    if (icon) {
       Display* disp = m_listen_to.sbWindow().display();
 
-      if (m_icon_mask.drawable() ) {
-        XSetClipMask(disp, gc(), m_icon_mask.drawable() );
+      if (icon->mask().drawable() ) {
+        XSetClipMask(disp, gc(), icon->mask().drawable() );
         XSetClipOrigin(disp, gc(), 2, 2);
       }
 
-      copyArea(m_icon_pixmap.drawable(), gc(),
+      copyArea(icon->pixmap().drawable(), gc(),
                0, 0, 2, 2,
-               m_icon_pixmap.width(), m_icon_pixmap.height() );
+               icon->width(), icon->height() );
 
-      if (m_icon_mask.drawable() )
+      if (icon->mask().drawable() )
         XSetClipMask(disp, gc(), None);
     } else {
       if ((w < 6) || (h < 6) )
@@ -227,28 +241,9 @@ void WinButton::clear() {
   drawType();
 }
 void WinButton::updateAll() {
-  int w = static_cast<int>(width() ) - 4;
-  int h = static_cast<int>(height() ) - 4;
-
-  // update the menu icon
-  if ((w > 0 && h > 0) && m_type == MENUICON && !m_listen_to.empty() ) {
-    Display* display = m_listen_to.sbWindow().display();
-    int screen = m_listen_to.screen().screenNumber();
-
-    Drawable d = m_listen_to.icon().pixmap().drawable();
-    if (d != None) {
-       m_icon_pixmap.copy(d, DefaultDepth(display, screen), screen);
-       m_icon_pixmap.scale(w, h);
-    } else
-      m_icon_pixmap.release();
-
-    d = m_listen_to.icon().mask().drawable();
-    if (d != None) {
-      m_icon_mask.copy(d, 0, 0);
-      m_icon_mask.scale(w, h);
-    } else
-      m_icon_mask.release();
-  } // if w & h & MENUICON & !empty
+  // update the menu icon, fills the cache for drawType
+  if (m_type == MENUICON)
+    scaledIcon();
 
   // pressed_pixmap isn't stateful in any current buttons, so no need
   // to potentially override that. Just make sure background pm is ok
@@ -9,6 +9,7 @@
 #define WINBUTTON_HH
 
 #include "tk/Button.hh"
+#include "tk/ObjectPool.hh"
 #include "tk/SbPixmap.hh"
 
 class ShyneboxWindow;
@@ -16,11 +17,14 @@ class WinButtonTheme;
 
 namespace tk{
 class Color;
+class PixmapWithMask;
 template <class T> class ThemeProxy;
 }
 
 class WinButton:public tk::Button {
 public:
+  TK_POOLED(WinButton)
+
   // draw type for the button
   enum Type {
       MAXIMIZE,
@@ -53,14 +57,12 @@ public:
 
 private:
   void drawType();
+  const tk::PixmapWithMask *scaledIcon() const;
   Pixmap getPixmap(const tk::ThemeProxy<WinButtonTheme> &) const;
   Type m_type;
   ShyneboxWindow &m_listen_to;
   tk::ThemeProxy<WinButtonTheme> &m_theme, &m_pressed_theme;
 
-  tk::SbPixmap m_icon_pixmap;
-  tk::SbPixmap m_icon_mask;
-
   bool overrode_bg, overrode_pressed;
 };
 
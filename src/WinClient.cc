@@ -11,9 +11,14 @@
 
 #include "tk/EventManager.hh"
 #include "tk/I18n.hh" // update title NLS
+#include "tk/IconCache.hh"
 
 #include <iostream>
+#include <map>
 #include <X11/Xatom.h>
+#ifdef HAVE_XSYNC
+#include <X11/extensions/sync.h>
+#endif
 
 #ifdef HAVE_CASSERT
   #include <cassert>
@@ -34,7 +39,8 @@ using std::dec;
 
 namespace {
 
-void sendMessage(const WinClient& win, Atom atom, Time time) {
+void sendMessage(const WinClient& win, Atom atom, Time time,
+                 long data2 = 0l, long data3 = 0l) {
   XEvent ce;
   ce.xclient.type = ClientMessage;
   ce.xclient.message_type = SbAtoms::instance()->getWMProtocolsAtom();
@@ -43,12 +49,19 @@ void sendMessage(const WinClient& win, Atom atom, Time time) {
   ce.xclient.format = 32;
   ce.xclient.data.l[0] = atom;
   ce.xclient.data.l[1] = time;
-  ce.xclient.data.l[2] = 0l;
-  ce.xclient.data.l[3] = 0l;
+  ce.xclient.data.l[2] = data2;
+  ce.xclient.data.l[3] = data3;
   ce.xclient.data.l[4] = 0l;
   XSendEvent(win.display(), win.window(), false, NoEventMask, &ce);
 }
 
+// alarm events only carry the alarm id
+std::map<XID, WinClient *> s_sync_alarms;
+
+// a client that is slow once (busy redrawing, swapping) keeps its sync,
+// one that keeps missing the deadline isn't waited for anymore
+const int SYNC_MAX_MISSES = 3;
+
 } // end of anonymous namespace
 
 WinClient::TransientWaitMap WinClient::s_transient_wait;
@@ -110,8 +123,7 @@ WinClient::WinClient(Window win, BScreen &screen, ShyneboxWindow *sbwin):
     s_transient_wait.erase(win);
   }
 
-  // title 'sig' done on timer
-  m_title_update_timer.setTimeout(10 * tk::SbTime::IN_MILLISECONDS);
+  // title 'sig' done on timer, see scheduleTitle()
   m_title_update_timer.fireOnce(true);
   tk::SimpleCommand<WinClient> *ets(new tk::SimpleCommand<WinClient>(*this, &WinClient::emitTitleSig) );
   m_title_update_timer.setCommand(*ets);
@@ -146,6 +158,7 @@ WinClient::~WinClient() {
   }
 
   accepts_input = send_focus_message = false;
+  destroySyncAlarm();
   if (sbwindow() != 0)
     sbwindow()->removeClient(*this);
 
@@ -165,6 +178,8 @@ WinClient::~WinClient() {
 
   if (m_mwm_hint != 0)
     XFree(m_mwm_hint);
+
+  tk::IconCache::forget(m_icon);
 } // WinClient class destroy
 
 bool WinClient::acceptsFocus() const {
@@ -308,6 +323,15 @@ void WinClient::updateTitle() {
 
     if (XGetWMName(display, window(), &text_prop)
         && text_prop.value && text_prop.nitems > 0) {
+      std::string raw(reinterpret_cast<char *>(text_prop.value),
+                      text_prop.nitems * (text_prop.format / 8) );
+      if (text_prop.encoding == m_title_encoding && raw == m_title_raw) {
+        XFree(text_prop.value);
+        return;
+      }
+      m_title_encoding = text_prop.encoding;
+      m_title_raw.swap(raw);
+
       if (text_prop.encoding != XA_STRING) {
         text_prop.nitems = strlen((char *) text_prop.value);
         XmbTextPropertyToTextList(display, &text_prop, &list, &num);
@@ -322,16 +346,63 @@ void WinClient::updateTitle() {
       } else // XA_STRING
         name = text_prop.value ? tk::SbStringUtil::XStrToSb((char *)text_prop.value) : "";
       XFree(text_prop.value);
-    } else // default name
+    } else { // default name
+      m_title_encoding = None;
+      m_title_raw.clear();
       name = _SB_XTEXT(Window, Unnamed, "Unnamed",
              "Default name for a window without a WM_NAME");
+    }
   } // if x-window
 
-  m_title.setLogical(tk::SbString(name, 0, 512) );
+  tk::SbString title(name, 0, 512);
+  if (title == m_title.logical() )
+    return;
+  m_title.setLogical(title);
+  m_title_changed = true;
+  scheduleTitle();
+}
+
+// some clients set _NET_WM_NAME for every line of output, this way they
+// cost one read per emitted title instead of one per change
+void WinClient::netTitleChanged(Atom prop) {
+  m_net_title_prop = prop;
+  scheduleTitle();
+}
+
+// a window gets at most one new title per titleUpdateInterval. the short
+// wait in any case merges the double sets some terminals do
+void WinClient::scheduleTitle() {
+  if (m_title_update_timer.isTiming() )
+    return;
+
+  uint64_t wait = 10 * tk::SbTime::IN_MILLISECONDS;
+  uint64_t next = m_title_emitted
+                  + Shynebox::instance()->getTitleUpdateInterval();
+  uint64_t now = tk::SbTime::mono();
+  if (next > now + wait)
+    wait = next - now;
+
+  m_title_update_timer.setTimeout(wait);
   m_title_update_timer.start();
 }
 
 void WinClient::emitTitleSig() {
+  if (m_net_title_prop != None) {
+    tk::SbString title = textProperty(m_net_title_prop);
+    m_net_title_prop = None;
+    // same rules as setTitle(), a managed title stays
+    if (!title.empty() && !m_title_managed && title != m_title.logical() ) {
+      m_title.setLogical(title);
+      m_title_changed = true;
+    }
+  }
+
+  if (!m_title_changed)
+    return;
+  m_title_changed = false;
+
+  m_title_emitted = tk::SbTime::mono();
+  screen().focusControl().windowUpdated(*sbwindow() );
   sbwindow()->setTitle(m_title.logical(), *this);
   // this now directly calls screen/tb/iconbar to
   // update a single iconbutton title
@@ -343,12 +414,16 @@ void WinClient::emitTitleSig() {
 void WinClient::setTitle(const tk::SbString &title, bool managed) {
   if (m_title_managed && title != "")
     return;
-  m_title.setLogical(title);
-  m_title_update_timer.start();
   m_title_managed = managed; // locks out any future title changes!
+  if (title == m_title.logical() )
+    return;
+  m_title.setLogical(title);
+  m_title_changed = true;
+  scheduleTitle();
 }
 
 void WinClient::setIcon(const tk::PixmapWithMask& pm) {
+  tk::IconCache::forget(m_icon);
   m_icon.pixmap().copy(pm.pixmap() );
   m_icon.mask().copy(pm.mask() );
   m_icon_override = true;
@@ -414,6 +489,7 @@ void WinClient::updateWMHints() {
       window_group = wmhint->window_group;
 
     if (! m_icon_override) {
+      tk::IconCache::forget(m_icon);
       if ((bool)(wmhint->flags & IconPixmapHint) && wmhint->icon_pixmap != 0)
         m_icon.pixmap().copy(wmhint->icon_pixmap, 0, 0);
       else
@@ -561,20 +637,115 @@ void WinClient::updateWMProtocols() {
     // defaults
     send_focus_message = false;
     send_close_message = false;
+    send_sync_request = false;
     for (int i = 0; i < num_return; ++i) {
       if (proto[i] == sbatoms->getWMDeleteAtom() )
         send_close_message = true;
       else if (proto[i] == sbatoms->getWMTakeFocusAtom() )
         send_focus_message = true;
+      else if (proto[i] == sbatoms->getWMSyncRequestAtom() )
+        send_sync_request = true;
     }
 
     XFree(proto);
+    updateSyncCounter();
     if (sbwindow() )
       sbwindow()->updateFunctions();
   } else
     sbdbg<<"Warning: Failed to read WM Protocols.\n";
 }
 
+void WinClient::destroySyncAlarm() {
+  m_sync_waiting = false;
+  m_sync_misses = 0;
+  if (m_sync_alarm == 0)
+    return;
+
+  s_sync_alarms.erase(m_sync_alarm);
+#ifdef HAVE_XSYNC
+  XSyncDestroyAlarm(display(), m_sync_alarm);
+#endif
+  m_sync_alarm = 0;
+}
+
+void WinClient::updateSyncCounter() {
+  destroySyncAlarm();
+#ifdef HAVE_XSYNC
+  if (!send_sync_request || !Shynebox::instance()->haveSync() )
+    return;
+
+  bool exists = false;
+  XSyncCounter counter = getCardinalProperty(
+                           SbAtoms::instance()->getWMSyncCounterAtom(), &exists);
+  XSyncValue value;
+  if (!exists || counter == None
+      || !XSyncQueryCounter(display(), counter, &value) )
+    return;
+
+  // armed one past the current value, so it stays quiet until we ask
+  m_sync_value = ((int64_t)XSyncValueHigh32(value) << 32)
+                 | XSyncValueLow32(value);
+  XSyncAlarmAttributes attr;
+  attr.trigger.counter = counter;
+  attr.trigger.value_type = XSyncAbsolute;
+  attr.trigger.test_type = XSyncPositiveComparison;
+  XSyncIntsToValue(&attr.trigger.wait_value,
+                   (unsigned int)(m_sync_value + 1), (int)((m_sync_value + 1) >> 32) );
+  XSyncIntsToValue(&attr.delta, 0, 0);
+  attr.events = True;
+
+  m_sync_alarm = XSyncCreateAlarm(display(),
+                   XSyncCACounter | XSyncCAValueType | XSyncCAValue
+                   | XSyncCATestType | XSyncCADelta | XSyncCAEvents, &attr);
+  if (m_sync_alarm != 0)
+    s_sync_alarms[m_sync_alarm] = this;
+#endif // HAVE_XSYNC
+}
+
+bool WinClient::sendSyncRequest() {
+#ifdef HAVE_XSYNC
+  if (m_sync_alarm == 0)
+    return false;
+
+  ++m_sync_value;
+  XSyncAlarmAttributes attr;
+  XSyncIntsToValue(&attr.trigger.wait_value,
+                   (unsigned int)m_sync_value, (int)(m_sync_value >> 32) );
+  // changing the value re-arms the alarm
+  XSyncChangeAlarm(display(), m_sync_alarm, XSyncCAValue, &attr);
+
+  sendMessage(*this, SbAtoms::instance()->getWMSyncRequestAtom(),
+              Shynebox::instance()->getLastTime(),
+              (long)(m_sync_value & 0xffffffff), (long)(m_sync_value >> 32) );
+  m_sync_waiting = true;
+  return true;
+#else
+  return false;
+#endif // HAVE_XSYNC
+}
+
+void WinClient::syncMissed() {
+  m_sync_waiting = false;
+  if (++m_sync_misses >= SYNC_MAX_MISSES)
+    destroySyncAlarm();
+}
+
+void WinClient::syncAlarmNotify(XID alarm, int64_t value) {
+  auto it = s_sync_alarms.find(alarm);
+  if (it == s_sync_alarms.end() )
+    return;
+
+  WinClient *client = it->second;
+  // late answer to a request we already gave up on
+  if (!client->m_sync_waiting || value < client->m_sync_value)
+    return;
+
+  client->m_sync_waiting = false;
+  client->m_sync_misses = 0;
+  if (client->sbwindow() )
+    client->sbwindow()->syncDone(*client);
+}
+
 void WinClient::removeTransientFromWaitingList() {
   // holds the windows that dont have empty
   // transient waiting list
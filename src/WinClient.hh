@@ -15,6 +15,7 @@
 #include "Window.hh"
 #include "WindowState.hh"
 
+#include "tk/ObjectPool.hh"
 #include "tk/SbWindow.hh"
 
 class BScreen;
@@ -27,6 +28,8 @@ typedef std::string SbString;
 // Holds client window info
 class WinClient: public Focusable, public tk::SbWindow {
 public:
+  TK_POOLED(WinClient)
+
   typedef std::list<WinClient *> TransientList;
   // this structure only contains 3 elements... the Motif 2.0 structure contains
   // 5... we only need the first 3... so that is all we will define
@@ -50,9 +53,24 @@ public:
   // updates from wm class hints
   void updateWMProtocols();
 
+  // _NET_WM_SYNC_REQUEST, the client bumps a counter once it has handled
+  // a configure, so resizes can wait for it instead of flooding it
+  bool hasSyncRequest() const { return m_sync_alarm != 0; }
+  bool waitingForSync() const { return m_sync_waiting; }
+  // call right before a configure, false if the client can't do it
+  bool sendSyncRequest();
+  // client didn't answer in time. the configure goes out without waiting,
+  // only after a few misses in a row asking stops until it sets the
+  // counter again
+  void syncMissed();
+  void updateSyncCounter();
+  static void syncAlarmNotify(XID alarm, int64_t value);
+
   // override the title
   void setTitle(const tk::SbString &title, bool managed=false);
   void updateTitle();
+  // _NET_WM_NAME changed, it's read when the title timer fires
+  void netTitleChanged(Atom prop);
   // updates transient window information
   void updateTransientInfo();
 
@@ -135,8 +153,16 @@ private:
   // some transient (or us) is no longer modal
   void removeModal() { --m_modal_count; }
 
+  // titles go out on a timer, changes in between are merged
   tk::Timer m_title_update_timer;
+  uint64_t m_title_emitted = 0;
+  void scheduleTitle();
   void emitTitleSig();
+  bool m_title_changed = false;
+  Atom m_net_title_prop = None; // to read before the next emit
+  // WM_NAME the title was made from, unchanged bytes aren't converted again
+  Atom m_title_encoding = None;
+  std::string m_title_raw;
 
   // number of transients which we are modal for
   int m_modal_count;
@@ -144,6 +170,12 @@ private:
   bool m_modal, accepts_input, send_focus_message,
        send_close_message, m_icon_override, m_title_managed;
 
+  void destroySyncAlarm();
+  bool send_sync_request = false, m_sync_waiting = false;
+  XID m_sync_alarm = 0;     // fires when the counter reaches m_sync_value
+  int64_t m_sync_value = 0; // last value requested
+  int m_sync_misses = 0;    // timeouts in a row
+
   WindowState::WindowType m_window_type;
   MwmHints *m_mwm_hint;
   SizeHints m_size_hints;
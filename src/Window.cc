@@ -40,6 +40,7 @@
 #include <iostream>
 #include <cassert>
 #include <functional>
+#include <algorithm>
 
 #include <unistd.h>
 
@@ -56,6 +57,11 @@ using namespace tk;
 
 namespace {
 
+// opaque resizes of clients without _NET_WM_SYNC_REQUEST go out at most once
+// a frame, sync clients get the time they need up to SYNC_TIMEOUT
+const uint64_t RESIZE_FRAME = tk::SbTime::IN_SECONDS / 60;
+const uint64_t SYNC_TIMEOUT = 500 * tk::SbTime::IN_MILLISECONDS;
+
 // X event scanner for enter/leave notifies - adapted from twm
 typedef struct scanargs {
   Window w;
@@ -206,6 +212,91 @@ WinButton* makeButton(ShyneboxWindow& win, FocusableTheme<WinButtonTheme>& bthem
   return new WinButton(win, btheme, theme, btype, parent, 0, 0, w, h);
 }
 
+// Everything a dragged window can snap to, built once per drag. Edges are
+// sorted by position so a motion event only looks at the few within the
+// threshold instead of every window on the workspace.
+// The result is the same as checking each box in turn, heads first, then
+// windows in list order, keeping the first of the closest edges.
+class SnapIndex {
+public:
+  struct Edge {
+    int pos, lo, hi;  // lo/hi: extent of the box along the edge
+    unsigned int seq; // box number * 4 + check, for ties
+    bool far;         // right or bottom edge
+  };
+
+  const ShyneboxWindow *owner = 0;
+  const Workspace *workspace = 0;
+  bool dirty = true;
+
+  void clear() {
+    m_x.clear();
+    m_y.clear();
+    m_boxes = 0;
+  }
+
+  void addBox(int left, int right, int top, int bottom) {
+    const unsigned int seq = 4 * m_boxes++;
+    m_x.push_back(Edge{ left, top, bottom, seq, false });
+    m_x.push_back(Edge{ right, top, bottom, seq + 2, true });
+    m_y.push_back(Edge{ top, left, right, seq, false });
+    m_y.push_back(Edge{ bottom, left, right, seq + 2, true });
+  }
+
+  void sort() {
+    auto by_pos = [](const Edge &a, const Edge &b) { return a.pos < b.pos; };
+    std::sort(m_x.begin(), m_x.end(), by_pos);
+    std::sort(m_y.begin(), m_y.end(), by_pos);
+    dirty = false;
+  }
+
+  void snap(int &xlimit, int &ylimit,
+            int left, int right, int top, int bottom, bool resize) const {
+    snapAxis(m_x, xlimit, left, right, top, bottom, resize);
+    snapAxis(m_y, ylimit, top, bottom, left, right, resize);
+  }
+
+private:
+  // near/far are my left/right (or top/bottom), lo/hi my extent across.
+  // only edges of boxes adjacent to us count, and when resizing the far
+  // side doesn't line up with far edges
+  static void snapAxis(const std::vector<Edge> &edges, int &limit,
+                       int near, int far, int lo, int hi, bool resize) {
+    const int range = abs(limit);
+    const int mine[2] = { near, far };
+    int best = range;
+    unsigned int best_seq = 0;
+
+    for (int m = 0; m < 2; m++) {
+      auto it = std::lower_bound(edges.begin(), edges.end(), mine[m] - range + 1,
+                      [](const Edge &e, int pos) { return e.pos < pos; });
+      for ( ; it != edges.end() && it->pos < mine[m] + range; ++it) {
+        if (it->lo > hi || it->hi < lo || (resize && m == 1 && it->far) )
+          continue;
+
+        const int d = abs(mine[m] - it->pos);
+        const unsigned int seq = it->seq + m;
+        if (d < best || (d == best && seq < best_seq) ) {
+          best = d;
+          best_seq = seq;
+          limit = it->pos - mine[m];
+        }
+      }
+    }
+  }
+
+  std::vector<Edge> m_x, m_y;
+  unsigned int m_boxes = 0;
+};
+
+SnapIndex s_snap;
+
+// other windows changing under a drag
+void snapTargetMoved(const ShyneboxWindow *win) {
+  if (win != s_snap.owner)
+    s_snap.dirty = true;
+}
+
 } // end anonymous namespace
 
 int ShyneboxWindow::s_num_grabs = 0;
@@ -297,12 +388,19 @@ ShyneboxWindow::ShyneboxWindow(WinClient &client):
     m_tab_activate_timer.setCommand(*activate_tab_cmd);
     m_tab_activate_timer.fireOnce(true);
 
-    m_resize_timer.setTimeout(screen().opaqueResizeDelay() * tk::SbTime::IN_MILLISECONDS);
+    m_resize_timer.setTimeout(max<uint64_t>(RESIZE_FRAME,
+                      screen().opaqueResizeDelay() * tk::SbTime::IN_MILLISECONDS) );
     tk::SimpleCommand<ShyneboxWindow> *resize_cmd(new tk::SimpleCommand<ShyneboxWindow>(*this,
                                                                  &ShyneboxWindow::updateResize) );
     m_resize_timer.setCommand(*resize_cmd);
     m_resize_timer.fireOnce(true);
 
+    m_sync_timer.setTimeout(SYNC_TIMEOUT);
+    tk::SimpleCommand<ShyneboxWindow> *sync_cmd(new tk::SimpleCommand<ShyneboxWindow>(*this,
+                                                               &ShyneboxWindow::syncTimeout) );
+    m_sync_timer.setCommand(*sync_cmd);
+    m_sync_timer.fireOnce(true);
+
     if (m_client->isTransient() && m_client->transientFor()->sbwindow() )
       m_state.stuck = m_client->transientFor()->sbwindow()->isStuck();
 
@@ -575,6 +673,9 @@ void ShyneboxWindow::attachClient(WinClient &client, int x, int y) {
     if (client_insert_pos != m_clientlist.end() )
       button_insert_pos = m_labelbuttons[*client_insert_pos];
 
+    // lay the tabs out once, not once per attached client
+    frame().tabcontainer().setUpdateLock(true);
+
     // make sure we set new window search for each client
     for (auto &client_it : old_win->clientList() ) {
       // reparent window to this
@@ -591,9 +692,14 @@ void ShyneboxWindow::attachClient(WinClient &client, int x, int y) {
         frame().moveLabelButtonLeftOf(*m_labelbuttons[client_it], *button_insert_pos);
     }
 
+    frame().tabcontainer().setUpdateLock(false);
+    frame().tabcontainer().update();
+
     // add client and move over all attached clients
     // from the old window to this list
-    m_clientlist.splice(client_insert_pos, old_win->m_clientlist);
+    m_clientlist.insert(client_insert_pos, old_win->m_clientlist.begin(),
+                        old_win->m_clientlist.end() );
+    old_win->m_clientlist.clear();
     updateClientLeftWindow();
     old_win->m_client = 0;
 
@@ -632,6 +738,7 @@ void ShyneboxWindow::attachClient(WinClient &client, int x, int y) {
         deiconify();
     }
   }
+  screen().focusControl().windowUpdated(*this);
   frame().reconfigure();
 } // attachClient
 
@@ -652,6 +759,7 @@ bool ShyneboxWindow::detachClient(WinClient &client) {
     (*client_it_after)->setGroupLeftWindow(leftwin);
 
   removeClient(client);
+  screen().focusControl().windowUpdated(*this);
   screen().createWindow(client);
   return true;
 }
@@ -682,7 +790,7 @@ bool ShyneboxWindow::removeClient(WinClient &client) {
 
   menu().hide();
 
-  m_clientlist.remove(&client);
+  m_clientlist.erase(find(m_clientlist.begin(), m_clientlist.end(), &client) );
 
   if (m_client == &client) {
     if (m_clientlist.empty() )
@@ -708,6 +816,11 @@ bool ShyneboxWindow::removeClient(WinClient &client) {
   return true;
 } // removeClient
 
+int ShyneboxWindow::clientIndex(const WinClient *client) const {
+  ClientList::const_iterator it = find(m_clientlist.begin(), m_clientlist.end(), client);
+  return it == m_clientlist.end() ? -1 : it - m_clientlist.begin();
+}
+
 WinClient *ShyneboxWindow::findClient(Window win) {
   for (auto it : clientList() )
     if (it->window() == win)
@@ -720,44 +833,32 @@ void ShyneboxWindow::nextClient() {
   if (numClients() <= 1)
     return;
 
-  ClientList::iterator it = find(m_clientlist.begin(), m_clientlist.end(),
-                                 m_client);
-  if (it == m_clientlist.end() )
+  const int idx = clientIndex(m_client);
+  if (idx < 0)
     return;
 
-  ++it;
-  if (it == m_clientlist.end() )
-    it = m_clientlist.begin();
-
-  setCurrentClient(**it, isFocused() );
+  setCurrentClient(*m_clientlist[(idx + 1) % numClients()], isFocused() );
 }
 
 void ShyneboxWindow::prevClient() {
   if (numClients() <= 1)
     return;
 
-  ClientList::iterator it = find(m_clientlist.begin(), m_clientlist.end(),
-                                 m_client);
-
-  if (it == m_clientlist.end() )
+  const int idx = clientIndex(m_client);
+  if (idx < 0)
     return;
 
-  if (it == m_clientlist.begin() )
-    it = m_clientlist.end();
-  --it;
-
-  setCurrentClient(**it, isFocused() );
+  setCurrentClient(*m_clientlist[(idx + numClients() - 1) % numClients()], isFocused() );
 }
 
 void ShyneboxWindow::moveClientLeft() {
   if (m_clientlist.size() == 1
-      || *m_clientlist.begin() == &winClient() )
+      || m_clientlist.front() == &winClient() )
     return;
 
   // move client in clientlist to the left
-  ClientList::iterator oldpos = find(m_clientlist.begin(), m_clientlist.end(), &winClient() );
-  ClientList::iterator newpos = oldpos; newpos--;
-  swap(*newpos, *oldpos);
+  const int idx = clientIndex(&winClient() );
+  swap(m_clientlist[idx - 1], m_clientlist[idx]);
   frame().moveLabelButtonLeft(*m_labelbuttons[&winClient()] );
 
   updateClientLeftWindow();
@@ -765,12 +866,11 @@ void ShyneboxWindow::moveClientLeft() {
 
 void ShyneboxWindow::moveClientRight() {
   if (m_clientlist.size() == 1
-      || *m_clientlist.rbegin() == &winClient() )
+      || m_clientlist.back() == &winClient() )
     return;
 
-  ClientList::iterator oldpos = find(m_clientlist.begin(), m_clientlist.end(), &winClient() );
-  ClientList::iterator newpos = oldpos; newpos++;
-  swap(*newpos, *oldpos);
+  const int idx = clientIndex(&winClient() );
+  swap(m_clientlist[idx + 1], m_clientlist[idx]);
   frame().moveLabelButtonRight(*m_labelbuttons[&winClient()]);
 
   updateClientLeftWindow();
@@ -840,23 +940,20 @@ void ShyneboxWindow::moveClientTo(WinClient &win, int x, int y) {
 void ShyneboxWindow::moveClientLeftOf(WinClient &win, WinClient &dest) {
   frame().moveLabelButtonLeftOf(*m_labelbuttons[&win], *m_labelbuttons[&dest]);
 
-  ClientList::iterator it = find(m_clientlist.begin(),
-                                 m_clientlist.end(),
-                                 &win);
-  ClientList::iterator new_pos = find(m_clientlist.begin(),
-                                      m_clientlist.end(),
-                                      &dest);
+  int idx = clientIndex(&win), new_idx = clientIndex(&dest);
 
   // make sure we found them
-  if (it == m_clientlist.end() || new_pos==m_clientlist.end() )
+  if (idx < 0 || new_idx < 0)
     return;
   // moving a button to the left of itself results in no change
-  if (new_pos == it)
+  if (new_idx == idx)
     return;
   //remove from list
-  m_clientlist.erase(it);
+  m_clientlist.erase(m_clientlist.begin() + idx);
+  if (new_idx > idx)
+    new_idx--;
   //insert on the new place
-  m_clientlist.insert(new_pos, &win);
+  m_clientlist.insert(m_clientlist.begin() + new_idx, &win);
 
   updateClientLeftWindow();
 }
@@ -865,30 +962,23 @@ void ShyneboxWindow::moveClientLeftOf(WinClient &win, WinClient &dest) {
 void ShyneboxWindow::moveClientRightOf(WinClient &win, WinClient &dest) {
   frame().moveLabelButtonRightOf(*m_labelbuttons[&win], *m_labelbuttons[&dest]);
 
-  ClientList::iterator it = find(m_clientlist.begin(),
-                                 m_clientlist.end(),
-                                 &win);
-  ClientList::iterator new_pos = find(m_clientlist.begin(),
-                                      m_clientlist.end(),
-                                      &dest);
+  int idx = clientIndex(&win), new_idx = clientIndex(&dest);
 
   // make sure we found them
-  if (it == m_clientlist.end() || new_pos==m_clientlist.end() )
+  if (idx < 0 || new_idx < 0)
     return;
 
   //moving a button to the right of itself results in no change
-  if (new_pos == it)
+  if (new_idx == idx)
     return;
 
   //remove from list
-  m_clientlist.erase(it);
+  m_clientlist.erase(m_clientlist.begin() + idx);
   //need to insert into the next position
-  new_pos++;
+  if (new_idx < idx)
+    new_idx++;
   //insert on the new place
-  if (new_pos == m_clientlist.end() )
-    m_clientlist.push_back(&win);
-  else
-    m_clientlist.insert(new_pos, &win);
+  m_clientlist.insert(m_clientlist.begin() + new_idx, &win);
 
   updateClientLeftWindow();
 }
@@ -938,6 +1028,7 @@ bool ShyneboxWindow::setCurrentClient(WinClient &client, bool setinput) {
   }
 
   m_client->raise();
+  frame().showTab(*button);
 
   sbdbg<<"ShyneboxWindow::"<<__FUNCTION__<<": labelbutton[client] = "<<
          button<<"\n";
@@ -946,6 +1037,8 @@ bool ShyneboxWindow::setCurrentClient(WinClient &client, bool setinput) {
     frame().setFocusTitle(title() );
     frame().setShapingClient(&client, false);
     applyDecorations();
+    // group lists match on the current client's title, class and so on
+    screen().focusControl().windowUpdated(*this);
   }
   return ret;
 } // setCurrentClient
@@ -1132,6 +1225,7 @@ void ShyneboxWindow::moveResize(int new_x, int new_y,
                                unsigned int new_width, unsigned int new_height,
                                bool send_event) {
   m_placed = true;
+  snapTargetMoved(this);
   send_event = send_event || frame().x() != new_x || frame().y() != new_y;
 
   if ((new_width != frame().width() || new_height != frame().height() )
@@ -1172,6 +1266,7 @@ void ShyneboxWindow::moveResizeForClient(int new_x, int new_y,
                                unsigned int new_width, unsigned int new_height,
                                int gravity, unsigned int client_bw) {
   m_placed = true;
+  snapTargetMoved(this);
   frame().moveResizeForClient(new_x, new_y, new_width, new_height, gravity, client_bw);
   setFocusFlag(m_focused);
   m_state.shaded = false;
@@ -1277,6 +1372,7 @@ void ShyneboxWindow::iconify() {
     return;
 
   m_state.iconic = true;
+  snapTargetsChanged();
   // remove from workspace list
   Shynebox::instance()->windowStateChanged(*this);
 
@@ -1304,6 +1400,7 @@ void ShyneboxWindow::deiconify(bool do_raise) {
   // reassociate first, so it gets removed from screen's icon list
   screen().reassociateWindow(this, m_workspace_number, false);
   m_state.iconic = false;
+  snapTargetsChanged();
   Shynebox::instance()->windowStateChanged(*this);
 
   // deiconify all transients
@@ -1967,6 +2064,8 @@ void ShyneboxWindow::propertyNotifyEvent(WinClient &client, Atom atom) {
       SbAtoms *sbatoms = SbAtoms::instance();
       if (atom == sbatoms->getWMProtocolsAtom() )
         client.updateWMProtocols();
+      else if (atom == sbatoms->getWMSyncCounterAtom() )
+        client.updateSyncCounter();
       else if (atom == sbatoms->getMWMHintsAtom() ) {
         client.updateMWMHints();
         updateMWMHintsFromClient(client);
@@ -2449,9 +2548,13 @@ void ShyneboxWindow::motionNotifyEvent(XMotionEvent &me) {
       } // if snap thresh != 0
 
       if (m_last_resize_w != old_resize_w || m_last_resize_h != old_resize_h) {
-        if (screen().doOpaqueResize() )
-          m_resize_timer.start();
-        else {
+        if (screen().doOpaqueResize() ) {
+          // sync clients set the pace themselves
+          if (m_client->hasSyncRequest() )
+            updateResize();
+          else
+            m_resize_timer.start();
+        } else {
           // draw over old rect
           parent().drawRectangle(screen().rootTheme()->opGC(),
                   old_resize_x, old_resize_y,
@@ -2466,12 +2569,19 @@ void ShyneboxWindow::motionNotifyEvent(XMotionEvent &me) {
         } // opaque resize
       } // m_last_resize_w/h != old
     } // if old_x != last_resize_x
-  } // resizing
+  } else if (me.window == frame().handle().window() )
+    frame().updateHandleCursor(me.x); // grips are ends of the handle
 } // motionNotifyEvent
 
 void ShyneboxWindow::enterNotifyEvent(XCrossingEvent &ev) {
   static ShyneboxWindow *s_last_really_entered = 0;
 
+  Shynebox::instance()->keys()->windowEntered(frame().window().window() );
+
+  // before the grab checks below, the pointer is over the handle either way
+  if (ev.window == frame().handle().window() )
+    frame().handleCrossing(true, ev.x);
+
   // if this results from an ungrab, only act if the window really changed.
   // otherwise we might pollute the focus which could have been assigned
   // by alt+tab (bug #597)
@@ -2519,6 +2629,9 @@ void ShyneboxWindow::enterNotifyEvent(XCrossingEvent &ev) {
 } // enterNotifyEvent
 
 void ShyneboxWindow::leaveNotifyEvent(XCrossingEvent &ev) {
+  if (ev.window == frame().handle().window() )
+    frame().handleCrossing(false, ev.x);
+
   // ignore grab activates, or if we're not visible
   if (ev.mode == NotifyGrab || ev.mode == NotifyUngrab
       || !isVisible() )
@@ -2554,6 +2667,8 @@ void ShyneboxWindow::frameExtentChanged() {
   if (!m_initialized)
     return;
 
+  snapTargetMoved(this);
+
   // updates EWMH
   Shynebox::instance()->updateFrameExtents(*this);
   sendConfigureNotify();
@@ -2647,6 +2762,7 @@ void ShyneboxWindow::startMoving(int x, int y) {
   m_button_grab_y = y - frame().y() - frame().window().borderWidth();
 
   moving = true;
+  snapTargetsChanged();
 
   Shynebox *shynebox = Shynebox::instance();
   // grabbing (and masking) on the root window allows us to
@@ -2705,36 +2821,59 @@ void ShyneboxWindow::stopMoving(bool interrupted) {
   }
 } // stopMoving
 
-namespace {
-// previously inlined, took up ~500 more bytes for i assume little performance
-void snapToWindow(int &xlimit, int &ylimit,
-                  int left, int right, int top, int bottom,
-                  int oleft, int oright, int otop, int obottom,
-                  bool resize) {
-  // Only snap if we're adjacent to the edge we're looking at
-
-  // for left + right, need to be in the right y range
-  if (top <= obottom && bottom >= otop) {
-    // left
-    if (abs(left-oleft)  < abs(xlimit) )               xlimit = -(left-oleft);
-    if (abs(right-oleft) < abs(xlimit) )               xlimit = -(right-oleft);
-    // right
-    if (abs(left-oright)  < abs(xlimit) )              xlimit = -(left-oright);
-    if (!resize && abs(right-oright) < abs(xlimit) )   xlimit = -(right-oright);
-  }
+void ShyneboxWindow::snapTargetsChanged() {
+  s_snap.dirty = true;
+}
 
-  // for top + bottom, need to be in the right x range
-  if (left <= oright && right >= oleft) {
-    // top
-    if (abs(top-otop)    < abs(ylimit) )               ylimit = -(top-otop);
-    if (abs(bottom-otop) < abs(ylimit) )               ylimit = -(bottom-otop);
-    // bottom
-    if (abs(top-obottom) < abs(ylimit) )               ylimit = -(top-obottom);
-    if (!resize && abs(bottom-obottom) < abs(ylimit) ) ylimit = -(bottom-obottom);
-  }
-} // snapToWindow
+void ShyneboxWindow::buildSnapIndex() {
+  s_snap.clear();
+  s_snap.owner = this;
+  s_snap.workspace = screen().currentWorkspace();
+
+  // begin with the screen (xrandr 'head') edges
+  int cur_head = 0, // head "0" == whole screen width + height
+      max_head = screen().numHeads();
+  if (!screen().doObeyHeads() )  // skip head snapping
+    max_head = 0;
+  else if (max_head > 1)
+    cur_head = 1;
+
+  for ( ; cur_head < max_head ; cur_head++)
+    s_snap.addBox(screen().maxLeft(cur_head),
+                  screen().maxRight(cur_head),
+                  screen().maxTop(cur_head),
+                  screen().maxBottom(cur_head) );
+
+  // then window edges
+  for (auto &it : s_snap.workspace->windowList() ) {
+    if (it == this || it->isIconic() )
+      continue; // skip self and minimized windows
+
+    const int it_bw = it->decorationMask() & (WindowState::DECORM_BORDER|WindowState::DECORM_HANDLE)
+                      ? it->frame().window().borderWidth() * 2 : 0,
+              it_x = it->x(),
+              it_y = it->y(),
+              it_w = it->width() + it_bw,
+              it_h = it->height() + it_bw;
+
+    s_snap.addBox(it_x, it_x + it_w, it_y, it_y + it_h);
 
-} // anonymous namespace
+    // also snap to the box containing the tabs
+    if (it->frame().externalTabMode() ) {
+      const int   it_xoff = it->xOffset(),
+                  it_yoff = it->yOffset(),
+                  it_woff = it->widthOffset(),
+                  it_hoff = it->heightOffset();
+
+      s_snap.addBox(it_x - it_xoff,
+                    it_x - it_xoff + it_w + it_woff,
+                    it_y - it_yoff,
+                    it_y - it_yoff + it_h + it_hoff);
+    }
+  } // for ws windows
+
+  s_snap.sort();
+} // buildSnapIndex
 
 void ShyneboxWindow::doSnapping(int &orig_left, int &orig_top, bool resize) {
   int threshold; // also bool 'do_snapping?'
@@ -2757,9 +2896,7 @@ void ShyneboxWindow::doSnapping(int &orig_left, int &orig_top, bool resize) {
       my_left  = orig_left,
       // border width centering is handled elsewhere, only apply to right/bot
       my_right = orig_left + width() + my_bw,
-      my_bot   = orig_top + height() + my_bw,
-      cur_head = 0, // head "0" == whole screen width + height
-      max_head = screen().numHeads();
+      my_bot   = orig_top + height() + my_bw;
 
   // only check self against tabs, other windows will check w/ and w/o tab
   if (external_tabs) {
@@ -2769,55 +2906,12 @@ void ShyneboxWindow::doSnapping(int &orig_left, int &orig_top, bool resize) {
     my_bot   += heightOffset() - yOffset();
   }
 
-  // begin by checking the screen (xrandr 'head') edges
+  // rebuilt when the window set changed, or we were dragged to another workspace
+  if (s_snap.dirty || s_snap.owner != this
+      || s_snap.workspace != screen().currentWorkspace() )
+    buildSnapIndex();
 
-  if (!screen().doObeyHeads() )  // skip head snapping
-    max_head = 0;
-  else if (max_head > 1)
-    cur_head = 1;
-
-  for ( ; cur_head < max_head ; cur_head++)
-    snapToWindow(dx, dy, my_left, my_right, my_top, my_bot,
-                 screen().maxLeft(cur_head),
-                 screen().maxRight(cur_head),
-                 screen().maxTop(cur_head),
-                 screen().maxBottom(cur_head),
-                 resize);
-
-  // now check window edges
-  for (auto &it : screen().currentWorkspace()->windowList() ) {
-    if (it == this || it->isIconic() )
-      continue; // skip self and minimized windows
-
-    const int it_bw = it->decorationMask() & (WindowState::DECORM_BORDER|WindowState::DECORM_HANDLE)
-                      ? it->frame().window().borderWidth() * 2 : 0,
-              it_x = it->x(),
-              it_y = it->y(),
-              it_w = it->width() + it_bw,
-              it_h = it->height() + it_bw;
-
-    snapToWindow(dx, dy, my_left, my_right, my_top, my_bot,
-                 it_x,
-                 it_x + it_w,
-                 it_y,
-                 it_y + it_h,
-                 resize);
-
-    // also snap to the box containing the tabs
-    if (it->frame().externalTabMode() ) {
-      const int   it_xoff = it->xOffset(),
-                  it_yoff = it->yOffset(),
-                  it_woff = it->widthOffset(),
-                  it_hoff = it->heightOffset();
-
-      snapToWindow(dx, dy, my_left, my_right, my_top, my_bot,
-                   it_x - it_xoff,
-                   it_x - it_xoff + it_w + it_woff,
-                   it_y - it_yoff,
-                   it_y - it_yoff + it_h + it_hoff,
-                   resize);
-    }
-  } // for ws windows
+  s_snap.snap(dx, dy, my_left, my_right, my_top, my_bot, resize);
 
   // commit
   if (dx <= threshold)
@@ -2880,6 +2974,7 @@ void ShyneboxWindow::startResizing(int x, int y, ReferenceCorner dir) {
 
   m_resize_corner = dir;
   resizing = true;
+  snapTargetsChanged();
   disableMaximization();
 
   const Cursor& cursor = (m_resize_corner == LEFTTOP) ? frame().theme()->upperLeftAngleCursor() :
@@ -2912,8 +3007,37 @@ void ShyneboxWindow::startResizing(int x, int y, ReferenceCorner dir) {
                    m_last_resize_h - 1 + 2 * frame().window().borderWidth() );
 } // startResizing
 
+void ShyneboxWindow::updateResize() {
+  if (m_client->waitingForSync() )
+    return; // syncDone() comes back for the latest size
+
+  // only a real size change makes the client answer
+  if (((unsigned int)m_last_resize_w != frame().width()
+       || (unsigned int)m_last_resize_h != frame().height() )
+      && m_client->sendSyncRequest() )
+    m_sync_timer.start();
+
+  moveResize(m_last_resize_x, m_last_resize_y, m_last_resize_w, m_last_resize_h);
+}
+
+void ShyneboxWindow::syncDone(WinClient &client) {
+  m_sync_timer.stop();
+  if (resizing && &client == m_client && screen().doOpaqueResize() )
+    updateResize();
+}
+
+void ShyneboxWindow::syncTimeout() {
+  for (auto &it : m_clientlist)
+    if (it->waitingForSync() )
+      it->syncMissed();
+
+  if (resizing && screen().doOpaqueResize() )
+    updateResize();
+}
+
 void ShyneboxWindow::stopResizing(bool interrupted) {
   resizing = false;
+  m_resize_timer.stop();
 
   if (!screen().doOpaqueResize() )
     parent().drawRectangle(screen().rootTheme()->opGC(),
@@ -20,6 +20,7 @@
 #include "tk/SbTime.hh"
 #include "tk/EventHandler.hh"
 #include "tk/LayerItem.hh"
+#include "tk/ObjectPool.hh"
 
 #include <vector>
 #include <map>
@@ -51,6 +52,8 @@ namespace Focus {
 class ShyneboxWindow: public Focusable,
                       public tk::EventHandler {
 public:
+  TK_POOLED(ShyneboxWindow)
+
   // Motif wm Hints
   enum {
       MwmHintsFunctions   = (1l << 0), // use motif wm functions
@@ -108,7 +111,8 @@ public:
        CENTER       = 8
   };
 
-  typedef std::list<WinClient *> ClientList;
+  // tab order, indexed so tab commands don't walk a list
+  typedef std::vector<WinClient *> ClientList;
 
   // create a window from a client
   ShyneboxWindow(WinClient &client);
@@ -127,6 +131,7 @@ public:
   // set new current client and raise it
   bool setCurrentClient(WinClient &client, bool setinput = true);
   WinClient *findClient(Window win);
+  int clientIndex(const WinClient *client) const; // -1 if not ours
   void nextClient();
   void prevClient();
   void moveClientLeft();
@@ -223,6 +228,10 @@ public:
   // move to pos x,y and resize client window to size width, height
   void moveResizeForClient(int x, int y, unsigned int width, unsigned int height,
                            int gravity = ForgetGravity, unsigned int client_bw = 0);
+  // client answered a _NET_WM_SYNC_REQUEST, send it the latest size
+  void syncDone(WinClient &client);
+  // windows were added or removed, snapping has to look again
+  static void snapTargetsChanged();
   // get max size from all clients using window hints
   void getMaxSize(unsigned int* width, unsigned int* height) const;
   void setWorkspace(int n);
@@ -393,12 +402,15 @@ private:
 
   // modifies left and top if snap is necessary
   void doSnapping(int &left, int &top, bool resize = false);
+  // edges doSnapping looks at, for the current workspace
+  void buildSnapIndex();
   // don't allow small windows, negative sizes, and obey window size hints
   void fixSize();
   void moveResizeClient(WinClient &client);
   // sends configurenotify to all clients
   void sendConfigureNotify();
-  void updateResize() { moveResize(m_last_resize_x, m_last_resize_y, m_last_resize_w, m_last_resize_h); }
+  void updateResize();
+  void syncTimeout();
 
   static void grabPointer(Window grab_window,
                    Bool owner_events,
@@ -418,7 +430,8 @@ private:
   uint64_t m_last_keypress_time;
   tk::Timer m_raise_timer,
             m_tab_activate_timer,
-            m_resize_timer;
+            m_resize_timer,
+            m_sync_timer; // stops waiting on a late sync answer
 
   // Window states - note: different than WindowState class
   bool moving, resizing, m_initialized;
@@ -40,6 +40,7 @@ void Workspace::addWindow(ShyneboxWindow &w) {
       return;
 
   m_windowlist.push_back(&w);
+  ShyneboxWindow::snapTargetsChanged();
 }
 
 // still_alive is true if the window will continue to exist after
@@ -59,6 +60,7 @@ int Workspace::removeWindow(ShyneboxWindow *w, bool still_alive) {
     FocusControl::unfocusWindow(w->winClient(), true, true);
 
   m_windowlist.remove(w);
+  ShyneboxWindow::snapTargetsChanged();
 
   return m_windowlist.size();
 }
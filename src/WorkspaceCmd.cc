@@ -237,7 +237,9 @@ REGISTER_COMMAND_PARSER(gotowindow, GoToWindowCmd::parse, void);
 void GoToWindowCmd::execute() {
   BScreen *screen = Shynebox::instance()->keyScreen();
   const FocusableList *win_list =
-      FocusableList::getListFromOptions(*screen, m_option);
+      screen->focusControl().filteredList(m_option, m_pat);
+  if (!win_list)
+    win_list = FocusableList::getListFromOptions(*screen, m_option);
   screen->focusControl().goToWindowNumber(*win_list, m_num, &m_pat);
 }
 
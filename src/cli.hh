@@ -30,6 +30,7 @@ struct Options {
   std::string rc_path;
   std::string rc_file;
   std::string log_filename;
+  std::string trace_filename;
   bool xsync;
 };
 
@@ -87,6 +87,13 @@ int ShyneboxCli::Options::parse(int argc, char** argv) {
           return EXIT_FAILURE;
         }
         this->log_filename = argv[i];
+      } else if (arg == "-trace" || arg == "--trace") {
+        if (++i >= argc) {
+          cerr<<_SB_CONSOLETEXT(main, TRACERequiresArg,
+                                "error: '-trace' needs an argument", "")<<"\n";
+          return EXIT_FAILURE;
+        }
+        this->trace_filename = argv[i];
       } else if (arg == "-sync" || arg == "--sync") {
         this->xsync = true;
       } else if (arg == "-help" || arg == "-h" || arg == "--help") {
@@ -102,6 +109,7 @@ int ShyneboxCli::Options::parse(int argc, char** argv) {
              << "-list-commands\t\t\tlist all valid key commands.\n"
              << "-sync\t\t\t\tsynchronize with X server for debugging.\n"
              << "-log <filename>\t\t\tlog output to file.\n"
+             << "-trace <filename>\t\trecord events for sbbench -replay.\n"
              << "-help\t\t\t\tdisplay this help text and exit.\n\n";
         // NLS
         //printf(_SB_CONSOLETEXT(main, Usage,
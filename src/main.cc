@@ -26,6 +26,7 @@
 #endif
 
 
+#include <cerrno>
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
@@ -53,10 +54,14 @@ void handleSignal(int signum) {
   static int re_enter = 0;
 
   switch (signum) {
-  case SIGCHLD: // we don't want the child process to kill us
-      // more than one process may have terminated
+  case SIGCHLD: { // we don't want the child process to kill us
+      // more than one process may have terminated. this can land in the
+      // middle of any call in the event loop, so keep its errno intact
+      int saved_errno = errno;
       while (waitpid(-1, 0, WNOHANG | WUNTRACED) > 0);
+      errno = saved_errno;
       break;
+  }
   case SIGHUP:
       // xinit sends HUP when it wants to go down. there is no point in
       // restoring anything in the screens / workspaces, the connection
@@ -179,6 +184,8 @@ int main(int argc, char **argv) {
                   opts.rc_path,
                   opts.rc_file,
                   opts.xsync);
+      if (!opts.trace_filename.empty() )
+        shynebox->startTrace(opts.trace_filename);
       setupSignalHandling();
       shynebox->eventLoop();
       cerr << "Shynebox:  ... exiting event loop\n";
@@ -18,6 +18,7 @@
 #include "tk/Image.hh"
 #include "tk/ImageControl.hh"
 #include "tk/EventManager.hh"
+#include "tk/FileSaver.hh"
 #include "tk/StringUtil.hh"
 #include "tk/SimpleCommand.hh"
 #include "tk/Command.hh"
@@ -34,6 +35,9 @@
 #ifdef SHAPE
 #include <X11/extensions/shape.h>
 #endif
+#ifdef HAVE_XSYNC
+#include <X11/extensions/sync.h>
+#endif
 
 #include <X11/extensions/Xrandr.h>
 
@@ -125,6 +129,7 @@ public:
     if (k) {
       XRefreshKeyboardMapping(&(this->xmapping) );
       tk::KeyUtil::instance().loadModmap();
+      k->keymapChanged();
       k->regrab();
     }
   }
@@ -136,6 +141,8 @@ KeyReloadHelper s_key_reloader;
 int s_randr_event_type = 0; // the type number of randr event
 int s_shape_eventbase = 0;  // event base for shape events
 bool s_have_shape = false ; // if shape is supported by server
+int s_sync_eventbase = 0;   // event base for sync alarm events
+bool s_have_sync = false;   // if XSync is supported by server
 
 Shynebox* s_singleton = 0;
 
@@ -144,22 +151,24 @@ Shynebox* s_singleton = 0;
 
 bool Shynebox::haveShape() const { return s_have_shape; }
 int Shynebox::shapeEventbase() const { return s_shape_eventbase; }
+bool Shynebox::haveSync() const { return s_have_sync; }
 Shynebox* Shynebox::instance() { return s_singleton; }
 
 Shynebox::Config::Config(tk::ConfigManager& cm) :
-  colors_per_channel(*cm.get_cfgmap()["colorsPerChannel"]),
-  double_click_interval(*cm.get_cfgmap()["doubleClickInterval"]),
-  tabs_padding(*cm.get_cfgmap()["tabs.textPadding"]),
-  apps_file(*cm.get_cfgmap()["appsFile"]),
-  key_file(*cm.get_cfgmap()["keyFile"]),
-  menu_file(*cm.get_cfgmap()["menuFile"]),
-  overlay_file(*cm.get_cfgmap()["styleOverlay"]),
-  style_file(*cm.get_cfgmap()["styleFile"]),
-  winmenu_file(*cm.get_cfgmap()["windowMenuFile"]),
-  menusearch((tk::MenuMode_e&)(int&)(*cm.get_cfgmap()["menuSearch"]) ),
-  cache_life(*cm.get_cfgmap()["cacheLife"]),
-  cache_max(*cm.get_cfgmap()["cacheMax"]),
-  auto_raise_delay(*cm.get_cfgmap()["autoRaiseDelay"])
+  colors_per_channel(*cm[tk::CFG_COLORS_PER_CHANNEL]),
+  double_click_interval(*cm[tk::CFG_DOUBLE_CLICK_INTERVAL]),
+  tabs_padding(*cm[tk::CFG_TABS_TEXT_PADDING]),
+  apps_file(*cm[tk::CFG_APPS_FILE]),
+  key_file(*cm[tk::CFG_KEY_FILE]),
+  menu_file(*cm[tk::CFG_MENU_FILE]),
+  overlay_file(*cm[tk::CFG_STYLE_OVERLAY]),
+  style_file(*cm[tk::CFG_STYLE_FILE]),
+  winmenu_file(*cm[tk::CFG_WINDOW_MENU_FILE]),
+  menusearch((tk::MenuMode_e&)(int&)(*cm[tk::CFG_MENU_SEARCH]) ),
+  cache_life(*cm[tk::CFG_CACHE_LIFE]),
+  cache_max(*cm[tk::CFG_CACHE_MAX]),
+  auto_raise_delay(*cm[tk::CFG_AUTO_RAISE_DELAY]),
+  title_update_interval(*cm[tk::CFG_TITLE_UPDATE_INTERVAL])
 { }
 
 Shynebox::Shynebox(int argc, char **argv,
@@ -247,6 +256,13 @@ Shynebox::Shynebox(int argc, char **argv,
   m_key_reload_timer.setCommand(*rh_cmd);
   m_key_reload_timer.fireOnce(true);
 
+  // menu toggles each save, write them out together off the event loop
+  tk::SimpleCommand<Shynebox> *save_rc_cmd(
+    new tk::SimpleCommand<Shynebox>(*this, &Shynebox::writeRc) );
+  m_save_rc_timer.setTimeout(500 * tk::SbTime::IN_MILLISECONDS);
+  m_save_rc_timer.setCommand(*save_rc_cmd);
+  m_save_rc_timer.fireOnce(true);
+
   if (xsync)
     XSynchronize(disp, True);
 
@@ -256,6 +272,11 @@ Shynebox::Shynebox(int argc, char **argv,
   int shape_err;
   s_have_shape = XShapeQueryExtension(disp, &s_shape_eventbase, &shape_err);
 #endif
+#ifdef HAVE_XSYNC
+  int sync_err, sync_major, sync_minor;
+  s_have_sync = XSyncQueryExtension(disp, &s_sync_eventbase, &sync_err)
+                && XSyncInitialize(disp, &sync_major, &sync_minor);
+#endif
 
   int randr_error_base;
   XRRQueryExtension(disp, &s_randr_event_type, &randr_error_base);
@@ -403,7 +424,12 @@ Shynebox::~Shynebox() {
   delete m_key;
 
   delete m_ewmh;
-  delete m_remember;
+  delete m_remember; // writes a pending apps file
+
+  // a restart exec's right after this
+  if (m_save_rc_timer.isTiming() )
+    writeRc();
+  tk::FileSaver::instance().shutdown();
 
   if (m_shared_sv_rcfg_macro)
     delete m_shared_sv_rcfg_macro;
@@ -420,6 +446,9 @@ void Shynebox::eventLoop() {
       XEvent e;
       XNextEvent(disp, &e);
 
+      if (m_trace.isOpen() )
+        traceEvent(e);
+
       if (last_bad_window != None && e.xany.window == last_bad_window
           && e.type != DestroyNotify) { // we must let the actual destroys through
         if (e.type == FocusOut) {
@@ -440,6 +469,62 @@ void Shynebox::eventLoop() {
   } // while not shutdown
 } // eventLoop
 
+bool Shynebox::startTrace(const string &filename) {
+  if (!m_trace.open(filename) ) {
+    cerr << "Shynebox: can not write trace to " << filename << "\n";
+    return false;
+  }
+
+  // what a client usually sets before it maps
+  const char *names[] = {
+    "WM_NAME", "WM_ICON_NAME", "WM_CLASS", "WM_HINTS", "WM_NORMAL_HINTS",
+    "WM_PROTOCOLS", "_NET_WM_NAME", "_NET_WM_ICON_NAME", "_NET_WM_ICON",
+    "_NET_WM_WINDOW_TYPE", "_NET_WM_STATE", "_NET_WM_DESKTOP",
+    "_MOTIF_WM_HINTS",
+  };
+
+  m_trace_atoms.clear();
+  for (auto n : names)
+    m_trace_atoms.push_back(XInternAtom(display(), n, False) );
+
+  // clients that are already managed show up as if they were just mapped
+  for (auto it : m_window_search) {
+    XEvent e;
+    memset(&e, 0, sizeof(e) );
+    e.xmaprequest.type = MapRequest;
+    e.xmaprequest.window = it.first;
+    e.xmaprequest.parent = it.second->screen().rootWindow().window();
+    traceEvent(e);
+  }
+
+  return true;
+} // startTrace
+
+void Shynebox::traceClient(Window win) {
+  m_trace.geometry(display(), win);
+  for (auto atom : m_trace_atoms)
+    m_trace.property(display(), win, atom);
+}
+
+// the WM asks the server for most of what it needs to handle an event.
+// store those answers ahead of the event so a replay can set them up
+void Shynebox::traceEvent(const XEvent &e) {
+  if (e.type == MapRequest)
+    traceClient(e.xmaprequest.window);
+  else if (e.type == PropertyNotify && searchWindow(e.xproperty.window) )
+    m_trace.property(display(), e.xproperty.window, e.xproperty.atom);
+  else if (e.type == ClientMessage) {
+    static Atom net_wm_state = XInternAtom(display(), "_NET_WM_STATE", False);
+    m_trace.atom(display(), e.xclient.message_type);
+    if (e.xclient.message_type == net_wm_state) {
+      m_trace.atom(display(), e.xclient.data.l[1]);
+      m_trace.atom(display(), e.xclient.data.l[2]);
+    }
+  }
+
+  m_trace.event(e);
+}
+
 bool Shynebox::validateWindow(Window window) const {
   XEvent event;
   if (XCheckTypedWindowEvent(display(), window, DestroyNotify, &event) ) {
@@ -674,6 +759,15 @@ void Shynebox::handleEvent(XEvent * const e) {
       BScreen *scr = searchScreen(e->xany.window);
       scr->updateSize();
     }
+#ifdef HAVE_XSYNC
+    else if (s_have_sync && e->type == s_sync_eventbase + XSyncAlarmNotify)
+    {
+      XSyncAlarmNotifyEvent *ae = (XSyncAlarmNotifyEvent *)e;
+      WinClient::syncAlarmNotify(ae->alarm,
+                    ((int64_t)XSyncValueHigh32(ae->counter_value) << 32)
+                    | XSyncValueLow32(ae->counter_value) );
+    }
+#endif
     } // default
   } // switch(e->type)
 } // handleEvent
@@ -787,7 +881,10 @@ void Shynebox::clientDied(Focusable &focusable) {
 } // clientDied
 
 void Shynebox::windowWorkspaceChanged(ShyneboxWindow &win) {
-  m_ewmh->updateWorkspace(win);
+  win.screen().focusControl().windowUpdated(win);
+  // stuck windows stay at -1 (all workspaces) when they are carried along
+  if (!win.isStuck() || !win.screen().isChangingWorkspace() )
+    m_ewmh->updateWorkspace(win);
   if (win.isMoving() ) {
     win.raise();
     win.focus();
@@ -796,6 +893,7 @@ void Shynebox::windowWorkspaceChanged(ShyneboxWindow &win) {
 
 void Shynebox::windowStateChanged(ShyneboxWindow &win) {
   m_ewmh->updateState(win);
+  win.screen().focusControl().windowUpdated(win);
   // if window changed to iconic state
   // add to icon list
   if (win.isIconic() ) {
@@ -816,6 +914,7 @@ void Shynebox::windowStateChanged(ShyneboxWindow &win) {
 
 void Shynebox::windowLayerChanged(ShyneboxWindow &win) {
   m_ewmh->updateState(win);
+  win.screen().focusControl().windowUpdated(win);
 }
 
 void Shynebox::setupFrame(ShyneboxWindow &win) {
@@ -898,16 +997,21 @@ void Shynebox::shutdown(int x_wants_down) {
 
 /// saves resources
 void Shynebox::save_rc() {
+  if (!m_save_rc_timer.isTiming() )
+    m_save_rc_timer.start();
+} // save_rc
+
+void Shynebox::writeRc() {
   _SB_USES_NLS;
 
-  string cfgfile(getRcFilename() );
+  m_save_rc_timer.stop();
+  string cfgfile(tk::StringUtil::expandFilename(getRcFilename() ) );
 
-  if (!cfgfile.empty() ) {
-    if (!m_configmanager.save(cfgfile.c_str() ) )
-      cerr << "Error writing rc file! Check path, file permissions or if file is open.\n";
-  } else
+  if (!cfgfile.empty() )
+    tk::FileSaver::instance().write(cfgfile, m_configmanager.contents() );
+  else
     cerr<<_SB_CONSOLETEXT(Shynebox, BadRCFile, "rc filename is empty!", "Bad settings file")<<"\n";
-} // save_rc
+} // writeRc
 
 /// filename of resource file
 string Shynebox::getRcFilename() {
@@ -927,6 +1031,11 @@ void Shynebox::load_rc() {
 
   string cfgfile(getRcFilename() );
 
+  // the config in memory is newer than the file until it's written
+  if (m_save_rc_timer.isTiming()
+      || tk::FileSaver::instance().isPending(tk::StringUtil::expandFilename(cfgfile) ) )
+    return;
+
   // loads defaults regardless of file
   if (!m_configmanager.load(cfgfile.c_str() ) )
     cerr << _SB_CONSOLETEXT(Shynebox, CantLoadRCFile,
@@ -1033,9 +1142,15 @@ void Shynebox::workspaceCountChanged(BScreen& screen) {
   m_ewmh->updateWorkspaceCount(screen);
 }
 
+// end of BScreen::changeWorkspaceID, also publishes the focus
+// changes it held back
 void Shynebox::workspaceChanged(BScreen& screen) {
-  if (!m_state.starting)
-    m_ewmh->updateCurrentWorkspace(screen);
+  if (m_state.starting)
+    return;
+
+  m_ewmh->updateCurrentWorkspace(screen);
+  WinClient *client = FocusControl::focusedWindow();
+  m_ewmh->updateFocusedWindow(screen, client ? client->window() : 0);
 }
 
 void Shynebox::workspaceNamesChanged(BScreen &screen) {
@@ -1048,6 +1163,9 @@ void Shynebox::clientListChanged(BScreen &screen) {
 }
 
 void Shynebox::focusedWindowChanged(BScreen &screen, WinClient *client) {
+  if (screen.isChangingWorkspace() )
+    return; // see workspaceChanged()
+
   m_ewmh->updateFocusedWindow(screen, client ? client->window() : 0);
 #if USE_TOOLBAR
   screen.updateToolbar(false);
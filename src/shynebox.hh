@@ -15,6 +15,7 @@
 
 #include "tk/App.hh"
 #include "tk/Config.hh" // map
+#include "tk/EventTrace.hh"
 #include "tk/MacroCommand.hh"
 #include "tk/MenuSearch.hh"
 #include "tk/Timer.hh"
@@ -63,6 +64,8 @@ public:
 
   void eventLoop();
   void flag_button_replay();
+  // record events to 'filename' for 'sbbench -replay'
+  bool startTrace(const std::string &filename);
 
   void grab();
   void ungrab();
@@ -93,6 +96,7 @@ public:
   time_t getAutoRaiseDelay() const                   { return m_config.auto_raise_delay; }
   unsigned int getCacheLife() const                  { return m_config.cache_life * tk::SbTime::IN_MINUTES; }
   unsigned int getCacheMax() const                   { return m_config.cache_max; }
+  uint64_t getTitleUpdateInterval() const            { return m_config.title_update_interval * tk::SbTime::IN_MILLISECONDS; }
 
   void maskWindowEvents(Window w, ShyneboxWindow *bw)
       { m_masked = w; m_masked_window = bw; }
@@ -104,6 +108,7 @@ public:
   // searchWindow on these windows will give the active client in the group
   void saveWindowSearchGroup(Window win, ShyneboxWindow *sbwin);
   void saveGroupSearch(Window win, WinClient *winclient);
+  // writes the rc file shortly after, toggles close together write once
   void save_rc();
   void removeWindowSearch(Window win);
   void removeWindowSearchGroup(Window win);
@@ -136,6 +141,8 @@ public:
 
   bool haveShape() const;
   int shapeEventbase() const;
+  // XSync alarms, for _NET_WM_SYNC_REQUEST
+  bool haveSync() const;
 
   BScreen *mouseScreen() { return m_active_screen.mouse; }
   BScreen *keyScreen() { return m_active_screen.key; }
@@ -171,8 +178,11 @@ public:
 private:
   std::string getRcFilename();
   void load_rc();
+  void writeRc();
   void real_reconfigure();
   void handleEvent(XEvent *xe);
+  void traceEvent(const XEvent &e);
+  void traceClient(Window win);
   void handleUnmapNotify(XUnmapEvent &ue);
   void handleClientMessage(XClientMessageEvent &ce);
 
@@ -199,7 +209,8 @@ private:
 
       tk::MenuMode_e &menusearch;
 
-      unsigned int &cache_life, &cache_max, &auto_raise_delay;
+      unsigned int &cache_life, &cache_max, &auto_raise_delay,
+                   &title_update_interval;
   } m_config;
 
   Keys *m_key = 0;
@@ -238,6 +249,7 @@ private:
   // when we execute reconfig command we must wait until next event round
   tk::Timer m_reconfig_timer;
   tk::Timer m_key_reload_timer;
+  tk::Timer m_save_rc_timer;
   bool m_showing_dialog;
 
   struct {
@@ -247,6 +259,9 @@ private:
   } m_state;
 
   int m_server_grabs;
+
+  tk::EventTrace::Writer m_trace;
+  std::vector<Atom> m_trace_atoms; // snapshotted on MapRequest
 };
 #endif // SHYNEBOX_HH
 
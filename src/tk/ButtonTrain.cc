@@ -7,7 +7,7 @@
 #include "TextUtils.hh"
 #include "EventManager.hh"
 
-#include <vector>
+#include <algorithm>
 
 #define ContAlignEnum ButtonTrainAlignment_e
 
@@ -42,15 +42,13 @@ void ButtonTrain::moveResize(int x, int y,
 }
 
 void ButtonTrain::insertItem(Item item) {
+  // the only way in, so this keeps the list free of duplicates
   if (find(item) != -1 || item->parent() != this)
     return;
 
   item->setOrientation(m_orientation);
   m_item_list.push_back(item);
 
-  // make sure we dont have duplicate items
-  m_item_list.unique();
-
   repositionItems();
 }
 
@@ -60,55 +58,64 @@ void ButtonTrain::moveItem(Item item, int movement) {
     return;
 
   int index = find(item);
-  const size_t size = m_item_list.size();
+  const int size = m_item_list.size();
 
-  if (index < 0 || (movement % static_cast<signed>(size) ) == 0)
+  if (index < 0 || (movement % size) == 0)
     return;
 
-  int newindex = (index + movement) % static_cast<signed>(size);
+  int newindex = (index + movement) % size;
   if (newindex < 0) // neg wrap
     newindex += size;
 
-  ItemList::iterator it = begin();
-  for (; it != end() ; ++it)
-    if (*it == item)
-      break;
-  m_item_list.erase(it);
-
-  for (it = begin(); newindex >= 0; ++it, --newindex)
-    if (newindex == 0)
-      break;
-
-  m_item_list.insert(it, item);
+  m_item_list.erase(begin() + index);
+  m_item_list.insert(begin() + newindex, item);
+  keepInView(newindex);
   repositionItems();
 }
 
 // frame tabs use ret value
 bool ButtonTrain::removeItem(Item item) {
-  ItemList::iterator it = begin();
-  for (; it != end() ; ++it) {
-    if (*it == item) {
-      m_item_list.erase(it);
-      repositionItems();
-      return true;
-    }
-  }
-  return false;
+  ItemList::iterator it = std::find(begin(), end(), item);
+  if (it == end() )
+    return false;
+
+  m_item_list.erase(it);
+  repositionItems();
+  return true;
 }
 
 void ButtonTrain::removeAll() {
   m_item_list.clear();
+  m_scroll = 0;
   if (!m_update_lock)
     clear();
 }
 
 int ButtonTrain::find(const Button * item) {
-  ItemList::iterator it = begin();
-  int index = 0;
-  for (; it != end(); ++it, ++index)
-    if ((*it) == item)
-      return index;
-  return -1;
+  ItemList::iterator it = std::find(begin(), end(), item);
+  return it == end() ? -1 : it - begin();
+}
+
+// only has an effect once a layout did not fit everything
+bool ButtonTrain::keepInView(int index) {
+  if (m_visible == 0 || index < 0)
+    return false;
+
+  int scroll = m_scroll;
+  if (index < scroll)
+    scroll = index;
+  else if (index >= scroll + m_visible)
+    scroll = index - m_visible + 1;
+
+  if (scroll == m_scroll)
+    return false;
+  m_scroll = scroll;
+  return true;
+}
+
+void ButtonTrain::showItem(const Button *item) {
+  if (keepInView(find(item) ) )
+    repositionItems();
 }
 
 void ButtonTrain::setMaxSizePerClient(unsigned int size) {
@@ -180,10 +187,14 @@ void ButtonTrain::repositionItems() {
   // within that bound
   ContAlignEnum align = alignment();
 
+  // relative items always share the space
+  bool squeezed = align > ContAlignEnum::RIGHT;
+
   // if LEFT || CENTER || RIGHT
   if (m_max_total_size && align <= ContAlignEnum::RIGHT) {
     total_width = (max_width_per_client + borderW) * num_items - borderW;
     if (total_width > m_max_total_size) {
+      squeezed = true;
       total_width = m_max_total_size;
       if (m_max_total_size > ((num_items - 1)*borderW) ) // don't go negative with unsigned nums
         max_width_per_client = (m_max_total_size - (num_items - 1)*borderW ) / num_items;
@@ -221,6 +232,12 @@ void ButtonTrain::repositionItems() {
     } // if auto_resize and total_width != cur_width
   } // if max_total_size and (LEFT || CENTER || RIGHT)
 
+  if (m_scrollable && squeezed && max_width_per_client < height) {
+    scrollItems(total_width, height, height);
+    return;
+  }
+  m_scroll = m_visible = 0;
+
   int rounding_error = 0;
   if (align == ContAlignEnum::RELATIVE || total_width == m_max_total_size)
     rounding_error = total_width -
@@ -311,6 +328,40 @@ void ButtonTrain::repositionItems() {
   } // for itemlist
 } // repositionItems
 
+// Every item gets the same size, as many as fit are placed from m_scroll
+// on and the rest is parked just outside on either side. So scrolling or
+// adding an item only moves the ones that come into or go out of view.
+void ButtonTrain::scrollItems(unsigned int total_width, unsigned int height,
+                              unsigned int min_width) {
+  const int num_items = m_item_list.size();
+  const int borderW = m_item_list.front()->borderWidth();
+
+  m_visible = std::max(1, int(total_width + borderW) / int(min_width + borderW) );
+  m_scroll = std::clamp(m_scroll, 0, std::max(0, num_items - m_visible) );
+
+  const unsigned int item_w = std::max(1, int(total_width + borderW) / m_visible - borderW);
+
+  int tmpx, tmpy;
+  unsigned int tmpw, tmph;
+  for (int i = 0; i < num_items; i++) {
+    if (i < m_scroll)
+      tmpx = -int(item_w + 2*borderW);
+    else if (i >= m_scroll + m_visible)
+      tmpx = total_width;
+    else
+      tmpx = -borderW + (i - m_scroll) * int(item_w + borderW);
+    tmpy = -borderW;
+    tmpw = item_w;
+    tmph = height;
+
+    translateCoords(m_orientation, tmpx, tmpy, total_width, height);
+    translatePosition(m_orientation, tmpx, tmpy, tmpw, tmph, borderW);
+    translateSize(m_orientation, tmpw, tmph);
+
+    m_item_list[i]->moveResize(tmpx, tmpy, tmpw, tmph);
+  }
+} // scrollItems
+
 unsigned int ButtonTrain::maxWidthPerClient() const {
   switch (alignment() ) {
   default:
@@ -4,6 +4,8 @@
   This holds buttons in a row (like a train). Used for tabs and iconbar.
   Toolbar also holds items but can hold iconbar which is of type ButtonTrain.
   Dynamically calculates positioning placement and sizes per item.
+  A scrollable train (window tabs) does not shrink items below its
+  height, items that do not fit are scrolled out of view instead.
 */
 
 #ifndef TK_BTNTRAIN_HH
@@ -15,7 +17,7 @@
 #include "Orientation.hh"
 #include "Config.hh"
 
-#include <list>
+#include <vector>
 #include <functional>
 
 namespace tk {
@@ -27,7 +29,7 @@ public:
   // LEFT, CENTER, RIGHT => fixed button size
   // RELATIVE/SMART => relative/variable button size
   typedef Button * Item;
-  typedef std::list<Item> ItemList;
+  typedef std::vector<Item> ItemList;
 
   explicit ButtonTrain(const SbWindow &parent, bool auto_resize = true);
   virtual ~ButtonTrain();
@@ -45,6 +47,9 @@ public:
   void setMaxTotalSize(unsigned int size);
   void setAlignment(tk::ButtonTrainAlignment_e a);
   void setOrientation(Orientation orient);
+  void setScrollable(bool value) { m_scrollable = value; }
+  // scroll so the item is in view, if not everything fits
+  void showItem(const Button *item);
 
   Item back() { return m_item_list.back(); }
 
@@ -74,6 +79,10 @@ public:
   void repositionItems();
 
 private:
+  void scrollItems(unsigned int total_width, unsigned int height,
+                   unsigned int min_width);
+  bool keepInView(int index);
+
   Orientation m_orientation;
 
   tk::ButtonTrainAlignment_e m_align;
@@ -81,6 +90,9 @@ private:
   unsigned int m_max_total_size;
   ItemList m_item_list;
   bool m_update_lock, m_auto_resize;
+  bool m_scrollable = false;
+  int m_scroll = 0;  // first item in view
+  int m_visible = 0; // items in view when scrolling, 0 if all fit
 };
 
 } // end namespace tk
@@ -3,13 +3,246 @@
 #include "Color.hh"
 
 #include "App.hh"
+#include "ColorNames.hh"
 #include "StringUtil.hh"
 #include "I18n.hh"
 
 #include <iostream>
+#include <map>
+#include <vector>
+
+#ifdef HAVE_CSTRING
+  #include <cstring>
+#else
+  #include <string.h>
+#endif
 
 using std::string;
 
+namespace {
+
+struct Rgb {
+  unsigned short red, green, blue; // 16 bit, like XColor
+};
+
+typedef unsigned long long RgbKey;
+
+RgbKey rgbKey(const Rgb &rgb) {
+  return ((RgbKey)rgb.red << 32) | ((RgbKey)rgb.green << 16) | rgb.blue;
+}
+
+// default visual of a screen. TrueColor pixels are made from the channel
+// masks, anything else gets colormap cells from the server, which are
+// shared between all Colors of the same rgb and freed with the last one
+struct ScreenColors {
+  bool init = false;
+  bool truecolor = false;
+  int shift[3], bits[3];
+
+  struct Cell {
+    int refs;
+    Rgb rgb; // what the server gave us
+  };
+  std::map<unsigned long, Cell> cells;
+  std::map<RgbKey, unsigned long> pixels; // requested rgb -> cell
+};
+
+// never deleted, Colors in other statics may go away after us
+std::vector<ScreenColors> *s_screens = 0;
+
+// names the server had to resolve, including the ones it did not know
+struct Parsed {
+  bool valid;
+  Rgb rgb;
+};
+std::map<string, Parsed> *s_parsed = 0;
+
+ScreenColors &screenColors(int screen) {
+  Display *disp = tk::App::instance()->display();
+  if (s_screens == 0)
+    s_screens = new std::vector<ScreenColors>(ScreenCount(disp) );
+
+  ScreenColors &sc = (*s_screens)[screen];
+  if (sc.init)
+    return sc;
+
+  sc.init = true;
+  Visual *vis = DefaultVisual(disp, screen);
+  if (vis->c_class != TrueColor)
+    return sc;
+
+  unsigned long masks[3] = { vis->red_mask, vis->green_mask, vis->blue_mask };
+  for (int i = 0; i < 3; i++) {
+    unsigned long m = masks[i];
+    sc.shift[i] = sc.bits[i] = 0;
+    if (m == 0)
+      return sc;
+    while (! (m & 1) ) { sc.shift[i]++; m >>= 1; }
+    while (m & 1)      { sc.bits[i]++;  m >>= 1; }
+    if (sc.bits[i] > 16)
+      sc.bits[i] = 16;
+  }
+  sc.truecolor = true;
+  return sc;
+}
+
+bool hexValue(const char *s, size_t len, unsigned int &val) {
+  val = 0;
+  for (size_t i = 0; i < len; i++) {
+    int c = tolower((unsigned char)s[i]);
+    if (c >= '0' && c <= '9')
+      val = val * 16 + c - '0';
+    else if (c >= 'a' && c <= 'f')
+      val = val * 16 + c - 'a' + 10;
+    else
+      return false;
+  }
+  return len > 0;
+}
+
+// the XParseColor formats we can do without the server
+//   #rgb - #rrrrggggbbbb   digits are the high bits of each channel
+//   rgb:r/g/b              1 - 4 digits per channel, scaled
+//   names from rgb.txt
+bool parseLocal(const string &str, Rgb &rgb) {
+  unsigned short *ch[3] = { &rgb.red, &rgb.green, &rgb.blue };
+  unsigned int v;
+
+  if (str[0] == '#') {
+    size_t n = (str.size() - 1) / 3;
+    if (n == 0 || n > 4 || n * 3 != str.size() - 1)
+      return false;
+    for (int i = 0; i < 3; i++) {
+      if (!hexValue(str.c_str() + 1 + i * n, n, v) )
+        return false;
+      *ch[i] = v << (16 - 4 * n);
+    }
+    return true;
+  }
+
+  if (strncasecmp(str.c_str(), "rgb:", 4) == 0) {
+    size_t pos = 4;
+    for (int i = 0; i < 3; i++) {
+      size_t end = i < 2 ? str.find('/', pos) : str.size();
+      if (end == string::npos || end - pos > 4
+          || !hexValue(str.c_str() + pos, end - pos, v) )
+        return false;
+      *ch[i] = v * 0xffff / ((1u << 4 * (end - pos) ) - 1);
+      pos = end + 1;
+    }
+    return true;
+  }
+
+  unsigned char r, g, b;
+  if (!tk::ColorNames::lookup(str.c_str(), r, g, b) )
+    return false;
+  rgb.red = r * 0x101;
+  rgb.green = g * 0x101;
+  rgb.blue = b * 0x101;
+  return true;
+}
+
+bool parse(const char *color_string, int screen, Rgb &rgb) {
+  string str = color_string;
+  tk::StringUtil::removeFirstWhitespace(str);
+  tk::StringUtil::removeTrailingWhitespace(str);
+
+  if (parseLocal(str, rgb) )
+    return true;
+
+  // rgbi:, CIE spaces or names only the server knows. ask once
+  if (s_parsed == 0)
+    s_parsed = new std::map<string, Parsed>;
+  auto it = s_parsed->find(str);
+  if (it == s_parsed->end() ) {
+    Display *disp = tk::App::instance()->display();
+    XColor color;
+    Parsed p;
+    p.valid = XParseColor(disp, DefaultColormap(disp, screen),
+                          str.c_str(), &color) != 0;
+    p.rgb.red = color.red;
+    p.rgb.green = color.green;
+    p.rgb.blue = color.blue;
+    it = s_parsed->insert(std::make_pair(str, p) ).first;
+  }
+  rgb = it->second.rgb;
+  return it->second.valid;
+}
+
+// rgb is changed to the color we really got
+bool acquire(int screen, Rgb &rgb, unsigned long &pixel) {
+  ScreenColors &sc = screenColors(screen);
+
+  if (sc.truecolor) {
+    unsigned short *ch[3] = { &rgb.red, &rgb.green, &rgb.blue };
+    pixel = 0;
+    for (int i = 0; i < 3; i++) {
+      unsigned long v = *ch[i] >> (16 - sc.bits[i]);
+      pixel |= v << sc.shift[i];
+      *ch[i] = v * 0xffff / ((1ul << sc.bits[i]) - 1);
+    }
+    return true;
+  }
+
+  const RgbKey key = rgbKey(rgb);
+  auto it = sc.pixels.find(key);
+  if (it != sc.pixels.end() ) {
+    ScreenColors::Cell &cell = sc.cells[it->second];
+    cell.refs++;
+    rgb = cell.rgb;
+    pixel = it->second;
+    return true;
+  }
+
+  Display *disp = tk::App::instance()->display();
+  Colormap colm = DefaultColormap(disp, screen);
+  XColor color;
+  color.red = rgb.red;
+  color.green = rgb.green;
+  color.blue = rgb.blue;
+  if (! XAllocColor(disp, colm, &color) )
+    return false;
+
+  ScreenColors::Cell &cell = sc.cells[color.pixel];
+  if (cell.refs > 0) // another rgb already holds this cell
+    XFreeColors(disp, colm, &color.pixel, 1, 0);
+  cell.refs++;
+  cell.rgb.red = color.red;
+  cell.rgb.green = color.green;
+  cell.rgb.blue = color.blue;
+  sc.pixels[key] = color.pixel;
+
+  rgb = cell.rgb;
+  pixel = color.pixel;
+  return true;
+}
+
+void retain(int screen, unsigned long pixel) {
+  ScreenColors &sc = screenColors(screen);
+  auto it = sc.cells.find(pixel);
+  if (it != sc.cells.end() )
+    it->second.refs++;
+}
+
+void release(int screen, unsigned long pixel) {
+  ScreenColors &sc = screenColors(screen);
+  auto it = sc.cells.find(pixel);
+  if (it == sc.cells.end() || --it->second.refs > 0)
+    return;
+
+  Display *disp = tk::App::instance()->display();
+  XFreeColors(disp, DefaultColormap(disp, screen), &pixel, 1, 0);
+  sc.cells.erase(it);
+  for (auto p = sc.pixels.begin(); p != sc.pixels.end(); ) {
+    if (p->second == pixel)
+      p = sc.pixels.erase(p);
+    else
+      ++p;
+  }
+}
+
+} // anonymous namespace
+
 namespace tk {
 
 Color::Color():
@@ -27,7 +260,7 @@ Color::Color(const Color &col_copy):
 
 Color::Color(unsigned short red, unsigned short green,
                       unsigned short blue, int screen):
-      m_red(red),	m_green(green), m_blue(blue),
+      m_red(0), m_green(0), m_blue(0),
       m_pixel(0), m_allocated(false),
       m_screen(screen) {
   allocate(red, green, blue, screen);
@@ -50,22 +283,15 @@ bool Color::setFromString(const char *color_string, int screen) {
     free();
     return false;
   }
-  string color_string_tmp = color_string;
-  StringUtil::removeFirstWhitespace(color_string_tmp);
-  StringUtil::removeTrailingWhitespace(color_string_tmp);
 
-  Display *disp = App::instance()->display();
-  Colormap colm = DefaultColormap(disp, screen);
-
-  XColor color;
-
-  if (! XParseColor(disp, colm, color_string_tmp.c_str(), &color) )
-    return false;
-  else if (! XAllocColor(disp, colm, &color) )
+  Rgb rgb;
+  unsigned long pixel;
+  if (!parse(color_string, screen, rgb) || !acquire(screen, rgb, pixel) )
     return false;
 
-  setPixel(color.pixel);
-  setRGB(color.red / 256, color.green / 256, color.blue / 256);
+  free();
+  setPixel(pixel);
+  setRGB(rgb.red / 256, rgb.green / 256, rgb.blue / 256);
   setAllocated(true);
   m_screen = screen;
 
@@ -73,15 +299,8 @@ bool Color::setFromString(const char *color_string, int screen) {
 }
 
 bool Color::validColorString(const char *color_string, int screen) {
-  XColor color;
-  Display *disp = App::instance()->display();
-  Colormap colm = DefaultColormap(disp, screen);
-  // trim white space
-  string color_string_tmp = color_string;
-  StringUtil::removeFirstWhitespace(color_string_tmp);
-  StringUtil::removeTrailingWhitespace(color_string_tmp);
-
-  return XParseColor(disp, colm, color_string_tmp.c_str(), &color) != 0;
+  Rgb rgb;
+  return color_string != 0 && parse(color_string, screen, rgb);
 }
 
 Color &Color::operator = (const Color &col_copy) {
@@ -95,9 +314,7 @@ Color &Color::operator = (const Color &col_copy) {
 
 void Color::free() {
   if (isAllocated() ) {
-    unsigned long pixel = m_pixel;
-    Display *disp = App::instance()->display();
-    XFreeColors(disp, DefaultColormap(disp, m_screen), &pixel, 1, 0);
+    release(m_screen, m_pixel);
     setPixel(0);
     setRGB(0, 0, 0);
     setAllocated(false);
@@ -112,32 +329,34 @@ void Color::copy(const Color &col_copy) {
     return;
   }
 
-  allocate(col_copy.red()*0x101,
-           col_copy.green()*0x101,
-           col_copy.blue()*0x101,
-           col_copy.m_screen);
+  // same cell, no need to ask the server again
+  retain(col_copy.m_screen, col_copy.pixel() );
+  free();
+  setRGB(col_copy.red(), col_copy.green(), col_copy.blue() );
+  setPixel(col_copy.pixel() );
+  setAllocated(true);
+  m_screen = col_copy.m_screen;
 }
 
 void Color::allocate(unsigned short red, unsigned short green,
                             unsigned short blue, int screen) {
-  Display *disp = App::instance()->display();
-  XColor color;
-  // fill xcolor structure
-  color.red = red;
-  color.green = green;
-  color.blue = blue;
+  Rgb rgb;
+  rgb.red = red;
+  rgb.green = green;
+  rgb.blue = blue;
+  unsigned long pixel;
 
-  if (!XAllocColor(disp, DefaultColormap(disp, screen), &color) ) {
+  if (!acquire(screen, rgb, pixel) ) {
     _SB_USES_NLS;
     std::cerr<<"tk::Color: "<<_TK_CONSOLETEXT(Error, ColorAllocation,
                 "Allocation error.", "XAllocColor failed...")<<"\n";
   } else {
     free();
-    setRGB(color.red / 256, color.green / 256, color.blue / 256);
-    setPixel(color.pixel);
+    setRGB(rgb.red / 256, rgb.green / 256, rgb.blue / 256);
+    setPixel(pixel);
     setAllocated(true);
+    m_screen = screen;
   }
-  m_screen = screen;
 }
 
 void Color::setRGB(unsigned short red, unsigned short green, unsigned short blue) {
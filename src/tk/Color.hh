@@ -2,8 +2,10 @@
 
 /*
   Allocates rgb color and pixel value.
-  Will use X functions to convert strings to colors from
-  #ff00ff, 'red' or r/g/b values.
+  Strings like #ff00ff, rgb:ff/0/ff or 'red' are parsed here from a copy
+  of rgb.txt, only other formats and names go to XParseColor (once).
+  On TrueColor the pixel comes from the visual masks without asking the
+  server, other visuals share refcounted colormap cells per rgb.
 */
 
 #ifndef TK_COLOR_HH
@@ -0,0 +1,44 @@
+// ColorNames.hh for Shynebox Window Manager
+
+/*
+  Built-in copy of the X11 rgb.txt color names, so styles can be resolved
+  without asking the server. Names are matched without case or spaces,
+  the same as the server does, 'Alice Blue' is 'aliceblue'.
+*/
+
+#ifndef TK_COLORNAMES_HH
+#define TK_COLORNAMES_HH
+
+namespace tk {
+
+namespace ColorNames {
+
+// false if the name is not in the table, rgb is 0 - 255
+bool lookup(const char *name, unsigned char &red, unsigned char &green,
+            unsigned char &blue);
+
+}
+
+} // namespace tk
+
+#endif // TK_COLORNAMES_HH
+
+// Copyright (c) 2023 Shynebox - zlice
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
@@ -9,6 +9,7 @@
 #include <iostream>
 #include <fstream>
 #include <cassert>
+#include <unordered_map>
 
 using std::ifstream;
 using std::ofstream;
@@ -71,6 +72,7 @@ const strstr dflts[] = {
   { 'i', "tabs.width",                       "64" },
   { 's', "titlebar.left",                    "Stick" },
   { 's', "titlebar.right",                   "Minimize Maximize Close" },
+  { 'u', "titleUpdateInterval",              "50" },
   { 'b', "toolbar.autoHide",                 "false" },
   { 'b', "toolbar.autoRaise",                "false" },
   { 'b', "toolbar.claimSpace",               "true" },
@@ -92,6 +94,18 @@ const strstr dflts[] = {
   { 'i', "workspaceWarpingVerticalOffset",   "1" },
 };
 
+static_assert(sizeof(dflts) / sizeof(dflts[0]) == CFG_COUNT,
+              "CfgSlot and dflts[] are out of sync");
+
+// lower cased key -> dflts[] index, so lines don't scan the whole table
+static const std::unordered_map<string, int> &dfltIndex() {
+  static std::unordered_map<string, int> index;
+  if (index.empty() )
+    for (int i = 0; i < CFG_COUNT; i++)
+      index[StringUtil::toLower(dflts[i].key)] = i;
+  return index;
+}
+
 // defaults list
 ////////////////////////////////////////////////////
 // CfgItm
@@ -141,7 +155,12 @@ set_strnum:
     *m_val.e = strval;                                         break;
 
   default:
-  case 's':           m_val.s = new string(strval);            break;
+  case 's': // keep references to the string valid
+    if (m_val.s)
+      *m_val.s = strval;
+    else
+      m_val.s = new string(strval);
+    break;
   }
 } // setFromString
 void CfgItm::setFromString(string strval) {
@@ -197,12 +216,18 @@ ConfigManager::~ConfigManager() {
 
 bool ConfigManager::load(const char *filename) {
   m_filename = StringUtil::expandFilename(filename).c_str();
+  m_saved.clear();
 
+  const std::unordered_map<string, int> &index = dfltIndex();
   string line;
   ifstream cfg_file(m_filename, ifstream::in);
 
   if (cfg_file.is_open() ) {
   while (!cfg_file.eof() && getline(cfg_file, line) ) {
+    if (!m_saved.empty() )
+      m_saved += '\n';
+    m_saved += line;
+
     string key;
     string val;
     // key: val (note the leading whitespace)
@@ -223,13 +248,11 @@ bool ConfigManager::load(const char *filename) {
 
     char type = 's'; // default type if not found
     if (val != "") { // if not comment or no colon
-      for (const auto [t, k, v] : dflts) {
-        if (StringUtil::strcasestr(k, key.c_str() ) ) {
-          type = t;
-          key = k; // want 'someThing' in config, not 'sOmEtHiNg'
-          break;
-        }
-      } // for
+      auto it = index.find(StringUtil::toLower(key) );
+      if (it != index.end() ) {
+        type = dflts[it->second].type;
+        key = dflts[it->second].key; // want 'someThing' in config, not 'sOmEtHiNg'
+      }
     } // if valid 'key: val'
 
     if (!cfgmap.count(key) ) // don't create dupes
@@ -239,51 +262,39 @@ bool ConfigManager::load(const char *filename) {
   } // if file opened
 
   // make sure at least defaults are loaded
-  for (const auto [t, k, v] : dflts)
-    if (cfgmap[k] == 0 // map[] auto-initializer, and a couple defaults are ""
-       || (cfgmap[k]->getString() == "" && StringUtil::strcasestr(v, "") ) ) {
-      cfgmap[k] = new CfgItm(t);
-      cfgmap[k]->setFromString(v);
+  for (int i = 0; i < CFG_COUNT; i++) {
+    const auto [t, k, v] = dflts[i];
+    CfgItm *&itm = cfgmap[k]; // map[] auto-initializer, and a couple defaults are ""
+    if (itm == 0 || (itm->getString() == "" && StringUtil::strcasestr(v, "") ) ) {
+      if (itm == 0 || itm->getType() != t)
+        itm = new CfgItm(t); // an old one may still be referenced
+      itm->setFromString(v);
     }
-
-// DUMP
-//  for (const auto [k, v] : cfgmap)
-//    sbdbg << "final init value --- " << k << " = " << v->getString() << "\n";
+    m_slots[i] = itm;
+  }
 
   return !cfg_file.fail(); // if !file error
 }
 
-bool ConfigManager::save(const char *filename) {
-  assert(filename);
-  // these must be local variables; otherwise, the memory gets released by
-  // std::string, causing weird issues
-  string file_str = StringUtil::expandFilename(filename);
-  filename = file_str.c_str();
-
-  string file_buf("");
-  const string colon = ": ";
-  const string newline = "\n";
-
-  ofstream cfg_file(filename, ofstream::trunc); // overwrite each time
-
-  if (cfg_file) { // opened fine, no fail/bad flag bits
-    for (auto [name, val] : cfgmap) {
-      if (val->getString() == "")   // commented out lines
-        file_buf += name + newline; // will always be at top
-      else
-        file_buf += name + colon + val->getString() + newline;
+string ConfigManager::contents() const {
+  string file_buf;
+  file_buf.reserve(m_saved.size() + 64);
+
+  for (auto [name, val] : cfgmap) {
+    const string str = val->getString();
+    file_buf += name;
+    if (str != "") { // else commented out line, will always be at top
+      file_buf += ": ";
+      file_buf += str;
     }
+    file_buf += '\n';
+  }
 
-    // could check file_buf size
-    // buf if there's 0 config items you have bigger problems
+  // could check file_buf size
+  // buf if there's 0 config items you have bigger problems
+  if (!file_buf.empty() )
     file_buf.pop_back(); // remove last newline
-
-    cfg_file << file_buf;
-    } // if file opened
-
-    m_filename = filename;
-
-  return !cfg_file.fail(); // if !file error
+  return file_buf;
 }
 
 } // end namespace tk
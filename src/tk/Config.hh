@@ -9,7 +9,8 @@
   cfgval : union to hold int/uint/strnum/str config values
   cfgitm : class to wrap access operators and hold cfgvals
   CFGMAP : actual map<string,cfgitm> that can hold a key/val pair
-  ConfigManager : the interface that loads and saves the cfgmap
+  CfgSlot : index of each default item, resolved once when loading
+  ConfigManager : the interface that loads the cfgmap and serializes it for saving
 */
 
 #ifndef TK_CONFIG_HH
@@ -45,6 +46,83 @@ struct strstr {
   const char *key, *val;
 };
 
+// slots of the items in dflts[], same order as the table in Config.cc
+// ConfigManager[CFG_X] is the item without a string lookup
+enum CfgSlot : int {
+  CFG_APPS_FILE,
+  CFG_AUTO_RAISE_DELAY,
+  CFG_AUTO_RAISE_WINDOWS,
+  CFG_CACHE_LIFE,
+  CFG_CACHE_MAX,
+  CFG_CLICK_RAISES_WINDOWS,
+  CFG_CLIENT_MENU_USE_PIXMAP,
+  CFG_COL_PLACEMENT_DIRECTION,
+  CFG_COLORS_PER_CHANNEL,
+  CFG_DEFAULT_DECO,
+  CFG_DOUBLE_CLICK_INTERVAL,
+  CFG_EDGE_RESIZE_SNAP_THRESHOLD,
+  CFG_EDGE_SNAP_THRESHOLD,
+  CFG_FOCUS_MODEL,
+  CFG_FOCUS_NEW_WINDOWS,
+  CFG_FOCUS_SAME_HEAD,
+  CFG_FULL_MAXIMIZATION,
+  CFG_ICONBAR_ALIGNMENT,
+  CFG_ICONBAR_ICON_TEXT_PADDING,
+  CFG_ICONBAR_ICON_WIDTH,
+  CFG_ICONBAR_ICONIFIED_PATTERN,
+  CFG_ICONBAR_MODE,
+  CFG_ICONBAR_USE_PIXMAP,
+  CFG_KEY_FILE,
+  CFG_MAX_DISABLE_MOVE,
+  CFG_MAX_DISABLE_RESIZE,
+  CFG_MAX_IGNORE_INCREMENT,
+  CFG_MENU_DELAY,
+  CFG_MENU_FILE,
+  CFG_MENU_SEARCH,
+  CFG_NO_FOCUS_WHILE_TYPING_DELAY,
+  CFG_OBEY_HEADS,
+  CFG_OPAQUE_MOVE,
+  CFG_OPAQUE_RESIZE,
+  CFG_OPAQUE_RESIZE_DELAY,
+  CFG_ROW_PLACEMENT_DIRECTION,
+  CFG_SHOW_WINDOW_POSITION,
+  CFG_STRFTIME_FORMAT,
+  CFG_STYLE_FILE,
+  CFG_STYLE_OVERLAY,
+  CFG_SYSTRAY_PIN_LEFT,
+  CFG_SYSTRAY_PIN_RIGHT,
+  CFG_TABS_FOCUS_MODEL,
+  CFG_TABS_IN_TITLEBAR,
+  CFG_TABS_MAX_OVER,
+  CFG_TABS_TEXT_PADDING,
+  CFG_TABS_PLACEMENT,
+  CFG_TABS_USE_PIXMAP,
+  CFG_TABS_WIDTH,
+  CFG_TITLEBAR_LEFT,
+  CFG_TITLEBAR_RIGHT,
+  CFG_TITLE_UPDATE_INTERVAL,
+  CFG_TOOLBAR_AUTO_HIDE,
+  CFG_TOOLBAR_AUTO_RAISE,
+  CFG_TOOLBAR_CLAIM_SPACE,
+  CFG_TOOLBAR_HEIGHT,
+  CFG_TOOLBAR_LAYER,
+  CFG_TOOLBAR_ON_HEAD,
+  CFG_TOOLBAR_PLACEMENT,
+  CFG_TOOLBAR_TOOLS,
+  CFG_TOOLBAR_VISIBLE,
+  CFG_TOOLBAR_WIDTH_PERCENT,
+  CFG_TOOLTIP_DELAY,
+  CFG_WINDOW_MENU_FILE,
+  CFG_WINDOW_PLACEMENT,
+  CFG_WORKSPACE_NAMES,
+  CFG_WORKSPACES,
+  CFG_WORKSPACE_WARPING_HORIZONTAL,
+  CFG_WORKSPACE_WARPING_HORIZONTAL_OFFSET,
+  CFG_WORKSPACE_WARPING_VERTICAL,
+  CFG_WORKSPACE_WARPING_VERTICAL_OFFSET,
+  CFG_COUNT
+};
+
 ////////////////////////////////////////////////////
 // strnum
 
@@ -202,6 +280,7 @@ public:
   void setFromString(std::string strval);
 
   std::string getString() const;
+  char getType() const { return type; }
 
   /* accessors (previous class)
   * TYPE SHOULDN'T CHANGE
@@ -251,14 +330,18 @@ public:
   // loads file and defaults into config map
   bool load(const char *filename);
 
-  /// saves config map to file
-  bool save(const char *filename);
+  /// config map as it is written to file, see tk::FileSaver
+  std::string contents() const;
 
   CFGMAP &get_cfgmap() { return cfgmap; }
+  // items in dflts[], always set after load()
+  CfgItm *operator[](CfgSlot slot) const { return m_slots[slot]; }
 
 private:
   CFGMAP cfgmap;
+  CfgItm *m_slots[CFG_COUNT] = { };
   std::string m_filename;
+  std::string m_saved; // contents of m_filename as loaded
 }; // ConfigManager
 
 } // namespace tk
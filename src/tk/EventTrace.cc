@@ -0,0 +1,276 @@
+// EventTrace.cc for Shynebox Window Manager
+
+#include "EventTrace.hh"
+#include "SbTime.hh"
+
+#include <X11/Xatom.h>
+
+#include <cstring>
+
+using std::string;
+
+namespace {
+
+const char MAGIC[] = "SBTRACE";
+const unsigned char TRACE_FORMAT_VERSION = 1;
+
+// largest property we bother with, big enough for a few icon sizes
+const long MAX_PROPERTY = 1 << 20;
+// atom names, nothing sane comes close
+const uint32_t MAX_STRING = 1 << 16;
+
+template <typename T>
+void put(std::ofstream &out, T val) {
+  out.write(reinterpret_cast<const char*>(&val), sizeof(T) );
+}
+
+template <typename T>
+bool get(std::ifstream &in, T &val) {
+  return (bool)in.read(reinterpret_cast<char*>(&val), sizeof(T) );
+}
+
+} // anonymous namespace
+
+namespace tk {
+
+namespace EventTrace {
+
+bool Writer::open(const string &filename) {
+  close();
+  m_out.open(filename.c_str(), std::ofstream::binary | std::ofstream::trunc);
+  if (!m_out.is_open() )
+    return false;
+
+  m_out.write(MAGIC, sizeof(MAGIC) - 1);
+  put<uint8_t>(m_out, TRACE_FORMAT_VERSION);
+  put<uint32_t>(m_out, sizeof(XEvent) );
+  m_start = SbTime::mono();
+  return !m_out.fail();
+}
+
+void Writer::close() {
+  if (m_out.is_open() )
+    m_out.close();
+  m_atoms.clear();
+  m_atom_records.clear();
+}
+
+void Writer::head(Kind kind) {
+  put<uint8_t>(m_out, kind);
+  put<uint64_t>(m_out, SbTime::mono() - m_start);
+}
+
+void Writer::str(const string &s) {
+  put<uint32_t>(m_out, s.size() );
+  m_out.write(s.data(), s.size() );
+}
+
+const string &Writer::atomName(Display *disp, Atom atom) {
+  auto it = m_atoms.find(atom);
+  if (it != m_atoms.end() )
+    return it->second;
+
+  string &name = m_atoms[atom];
+  char *n = atom == None ? 0 : XGetAtomName(disp, atom);
+  if (n) {
+    name = n;
+    XFree(n);
+  }
+  return name;
+}
+
+void Writer::event(const XEvent &ev) {
+  head(EVENT);
+  m_out.write(reinterpret_cast<const char*>(&ev), sizeof(XEvent) );
+}
+
+void Writer::property(Display *disp, Window win, Atom atom) {
+  Atom type = None;
+  int format = 0;
+  unsigned long nitems = 0, remain = 0;
+  unsigned char *data = 0;
+
+  if (XGetWindowProperty(disp, win, atom, 0, MAX_PROPERTY, False,
+                         AnyPropertyType, &type, &format, &nitems,
+                         &remain, &data) != Success || type == None) {
+    if (data)
+      XFree(data);
+    head(DELETE);
+    put<uint32_t>(m_out, win);
+    str(atomName(disp, atom) );
+    return;
+  }
+
+  head(PROPERTY);
+  put<uint32_t>(m_out, win);
+  str(atomName(disp, atom) );
+  str(atomName(disp, type) );
+  put<int32_t>(m_out, format);
+  put<uint32_t>(m_out, nitems);
+
+  // Xlib hands out format 32 as longs
+  if (format == 32) {
+    const long *l = reinterpret_cast<const long*>(data);
+    for (unsigned long i = 0; i < nitems; i++)
+      put<uint32_t>(m_out, l[i]);
+  } else
+    m_out.write(reinterpret_cast<const char*>(data), nitems * (format / 8) );
+
+  XFree(data);
+}
+
+void Writer::geometry(Display *disp, Window win) {
+  Window root;
+  int x = 0, y = 0;
+  unsigned int w = 0, h = 0, border, depth;
+
+  if (!XGetGeometry(disp, win, &root, &x, &y, &w, &h, &border, &depth) )
+    return;
+
+  head(GEOMETRY);
+  put<uint32_t>(m_out, win);
+  put<int32_t>(m_out, x);
+  put<int32_t>(m_out, y);
+  put<uint32_t>(m_out, w);
+  put<uint32_t>(m_out, h);
+}
+
+void Writer::atom(Display *disp, Atom atom) {
+  if (atom == None || !m_atom_records.insert(atom).second)
+    return;
+
+  const string &name = atomName(disp, atom);
+  if (name.empty() ) // not an atom after all
+    return;
+
+  head(ATOM);
+  put<uint32_t>(m_out, atom);
+  str(name);
+}
+
+bool Reader::open(const string &filename) {
+  m_in.open(filename.c_str(), std::ifstream::binary);
+  if (!m_in.is_open() ) {
+    m_error = "can not open " + filename;
+    return false;
+  }
+
+  char magic[sizeof(MAGIC) - 1];
+  uint8_t version = 0;
+  uint32_t evsize = 0;
+  m_in.read(magic, sizeof(magic) );
+  get(m_in, version);
+  get(m_in, evsize);
+
+  if (!m_in || memcmp(magic, MAGIC, sizeof(magic) ) != 0)
+    m_error = filename + " is not a shynebox trace";
+  else if (version != TRACE_FORMAT_VERSION)
+    m_error = filename + " has an unknown trace version";
+  else if (evsize != sizeof(XEvent) )
+    m_error = filename + " was recorded on a different architecture";
+  else
+    return true;
+
+  m_in.close();
+  return false;
+}
+
+bool Reader::str(string &s) {
+  uint32_t len;
+  if (!get(m_in, len) || len > MAX_STRING)
+    return false;
+  s.resize(len);
+  return len == 0 || m_in.read(&s[0], len);
+}
+
+bool Reader::next(Record &rec) {
+  uint8_t kind;
+  if (!m_in.is_open() || !get(m_in, kind) )
+    return false; // eof
+
+  rec.kind = kind;
+  uint32_t win = 0;
+  bool ok = get(m_in, rec.time);
+
+  switch (kind) {
+  case EVENT:
+    ok = ok && m_in.read(reinterpret_cast<char*>(&rec.event), sizeof(XEvent) );
+    break;
+  case PROPERTY: {
+    int32_t format;
+    uint32_t nitems;
+    ok = ok && get(m_in, win) && str(rec.name) && str(rec.type)
+            && get(m_in, format) && get(m_in, nitems);
+    // the writer asks for at most MAX_PROPERTY 32 bit units, anything
+    // bigger is a corrupt length and must not reach resize()
+    if (!ok || (format != 8 && format != 16 && format != 32)
+        || (uint64_t)nitems * (format / 8) > (uint64_t)MAX_PROPERTY * 4) {
+      ok = false;
+      break;
+    }
+
+    rec.format = format;
+    rec.nitems = nitems;
+    if (format == 32) {
+      rec.data.resize(nitems * sizeof(long) );
+      long *l = reinterpret_cast<long*>(rec.data.data() );
+      uint32_t v;
+      for (uint32_t i = 0; ok && i < nitems; i++) {
+        ok = get(m_in, v);
+        l[i] = v;
+      }
+    } else {
+      rec.data.resize(nitems * (format / 8) );
+      ok = (bool)m_in.read(reinterpret_cast<char*>(rec.data.data() ), rec.data.size() );
+    }
+    break;
+  }
+  case DELETE:
+  case ATOM:
+    ok = ok && get(m_in, win) && str(rec.name);
+    break;
+  case GEOMETRY: {
+    int32_t x, y;
+    uint32_t w, h;
+    ok = ok && get(m_in, win) && get(m_in, x) && get(m_in, y)
+            && get(m_in, w) && get(m_in, h);
+    rec.x = x; rec.y = y;
+    rec.width = w; rec.height = h;
+    break;
+  }
+  default:
+    ok = false;
+  }
+
+  rec.window = win;
+
+  if (!ok) {
+    m_error = "truncated or broken record";
+    m_in.close();
+  }
+  return ok;
+} // next
+
+} // namespace EventTrace
+
+} // namespace tk
+
+// Copyright (c) 2023 Shynebox - zlice
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
@@ -0,0 +1,127 @@
+// EventTrace.hh for Shynebox Window Manager
+
+/*
+  Binary trace of X events for offline profiling.
+
+  Writer is used by 'shynebox -trace <file>' and appends every event the
+  event loop pulls off the queue. Events alone are not enough to replay
+  anything useful, the WM reads titles, classes, hints and icons back
+  from the server. So for client windows the property the event points
+  at (and a set of them plus geometry on MapRequest) is snapshotted and
+  written before the event.
+
+  Reader is used by 'sbbench -replay <file>', which recreates the client
+  side of the trace on a fresh server.
+
+  Layout, native endian and XEvent size (trace is for the same machine):
+    header   "SBTRACE" version(u8) sizeof(XEvent)(u32)
+    record   kind(u8) usec since start(u64) data
+      EVENT      XEvent
+      PROPERTY   window(u32) name type format(i32) nitems(u32) items
+      DELETE     window(u32) name
+      GEOMETRY   window(u32) x y (i32) w h (u32)
+      ATOM       atom(u32) name, atoms inside events differ between servers
+    strings are u32 length + bytes, format 32 items are stored as u32
+*/
+
+#ifndef TK_EVENTTRACE_HH
+#define TK_EVENTTRACE_HH
+
+#include <X11/Xlib.h>
+
+#ifdef HAVE_INTTYPES_H
+#include <inttypes.h>
+#endif // HAVE_INTTYPES_H
+
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace tk {
+
+namespace EventTrace {
+
+enum Kind { EVENT = 1, PROPERTY, DELETE, GEOMETRY, ATOM };
+
+struct Record {
+  int kind;
+  uint64_t time;
+  XEvent event;
+  // PROPERTY/DELETE/GEOMETRY, atom for ATOM
+  Window window;
+  std::string name, type;
+  int format;
+  unsigned long nitems;
+  std::vector<unsigned char> data; // as XChangeProperty wants it
+  int x, y;
+  unsigned int width, height;
+};
+
+class Writer {
+public:
+  Writer() { }
+  ~Writer() { close(); }
+
+  bool open(const std::string &filename);
+  void close();
+  bool isOpen() const { return m_out.is_open(); }
+
+  void event(const XEvent &ev);
+  // reads the current value from the server, writes DELETE if it's gone
+  void property(Display *disp, Window win, Atom atom);
+  void geometry(Display *disp, Window win);
+  // name of an atom used by a following event, written once per atom
+  void atom(Display *disp, Atom atom);
+
+private:
+  void head(Kind kind);
+  void str(const std::string &s);
+  const std::string &atomName(Display *disp, Atom atom);
+
+  std::ofstream m_out;
+  uint64_t m_start = 0;
+  std::map<Atom, std::string> m_atoms;
+  std::set<Atom> m_atom_records;
+};
+
+class Reader {
+public:
+  bool open(const std::string &filename);
+  // false on end of file or a broken record
+  bool next(Record &rec);
+  const std::string &error() const { return m_error; }
+
+private:
+  bool str(std::string &s);
+
+  std::ifstream m_in;
+  std::string m_error;
+};
+
+} // namespace EventTrace
+
+} // namespace tk
+
+#endif // TK_EVENTTRACE_HH
+
+// Copyright (c) 2023 Shynebox - zlice
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
@@ -0,0 +1,115 @@
+// FileSaver.cc for Shynebox Window Manager
+
+#include "FileSaver.hh"
+#include "FileUtil.hh"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <signal.h>
+
+using std::string;
+
+namespace tk {
+
+FileSaver &FileSaver::instance() {
+  static FileSaver s_saver;
+  return s_saver;
+}
+
+void FileSaver::write(const string &filename, const string &data) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_thread.joinable() ) {
+    // the worker inherits this mask, SIGCHLD, SIGHUP and the like
+    // are for the main loop
+    sigset_t all, old;
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &old);
+    m_thread = std::thread(&FileSaver::run, this);
+    pthread_sigmask(SIG_SETMASK, &old, 0);
+  }
+  m_queue[filename] = data;
+  m_wake.notify_one();
+}
+
+bool FileSaver::isPending(const string &filename) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_current == filename || m_queue.find(filename) != m_queue.end();
+}
+
+void FileSaver::flush() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_done.wait(lock, [this] { return m_queue.empty() && m_current.empty(); });
+}
+
+void FileSaver::shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_quit = true;
+    m_wake.notify_one();
+  }
+  if (m_thread.joinable() )
+    m_thread.join();
+  m_quit = false;
+}
+
+void FileSaver::run() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_wake.wait(lock, [this] { return m_quit || !m_queue.empty(); });
+    if (m_queue.empty() ) // quitting and everything is written
+      break;
+
+    auto it = m_queue.begin();
+    const string filename = it->first;
+    string data;
+    data.swap(it->second);
+    m_queue.erase(it);
+    m_current = filename;
+
+    lock.unlock();
+    save(filename, data);
+    lock.lock();
+
+    m_current.clear();
+    m_done.notify_all();
+  }
+}
+
+// worker thread, nothing but files in here
+void FileSaver::save(const string &filename, const string &data) {
+  std::ifstream in(filename.c_str(), std::ifstream::binary);
+  if (in) {
+    std::ostringstream old;
+    old << in.rdbuf();
+    if (old.str() == data)
+      return;
+  }
+
+  if (!FileUtil::writeAtomic(filename.c_str(), data) )
+    std::cerr << "Error writing " << filename
+              << "! Check path, file permissions or if file is open.\n";
+}
+
+} // namespace tk
+
+// Copyright (c) 2023 Shynebox - zlice
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
@@ -0,0 +1,80 @@
+// FileSaver.hh for Shynebox Window Manager
+
+/*
+  Writes config files (init, apps) on a worker thread.
+
+  The caller serializes its state into a string on the main thread, that
+  string is the snapshot, and hands it over with write(). The worker
+  compares it against what is on disk and only writes changed files,
+  through FileUtil::writeAtomic. A newer write for a file that is still
+  queued replaces the older one.
+
+  Callers coalesce their own changes with a Timer, see Shynebox::save_rc
+  and Remember::save. The thread is started on the first write and must
+  be stopped with shutdown() before exiting or exec'ing for a restart.
+*/
+
+#ifndef TK_FILESAVER_HH
+#define TK_FILESAVER_HH
+
+#include "NotCopyable.hh"
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace tk {
+
+class FileSaver : private NotCopyable {
+public:
+  static FileSaver &instance();
+
+  // queue data to be written to filename, returns right away
+  void write(const std::string &filename, const std::string &data);
+  // filename is queued or being written, the file may still be old
+  bool isPending(const std::string &filename);
+  // wait until everything queued is on disk
+  void flush();
+  // flush and stop the worker, a later write starts it again
+  void shutdown();
+
+private:
+  FileSaver() { }
+  ~FileSaver() { shutdown(); }
+
+  void run();
+  static void save(const std::string &filename, const std::string &data);
+
+  std::mutex m_mutex;
+  std::condition_variable m_wake, m_done;
+  std::map<std::string, std::string> m_queue;
+  std::string m_current; // being written by the worker
+  std::thread m_thread;
+  bool m_quit = false;
+};
+
+} // namespace tk
+
+#endif // TK_FILESAVER_HH
+
+// Copyright (c) 2023 Shynebox - zlice
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
@@ -3,8 +3,13 @@
 #include "FileUtil.hh"
 
 #include <sys/stat.h>
+#include <fcntl.h>
 #include <unistd.h>
 
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+
 #include <iostream>
 #include <fstream>
 
@@ -68,6 +73,48 @@ bool FileUtil::copyFile(const char* from, const char* to) {
   return false;
 }
 
+bool FileUtil::writeAtomic(const char* filename, const std::string &data) {
+  if (!filename)
+    return false;
+
+  // a symlinked config (dotfile repos) should stay a symlink
+  std::string target = filename;
+  if (char *real = realpath(filename, 0) ) {
+    target = real;
+    free(real);
+  }
+
+  mode_t mode = 0644;
+  struct stat buf;
+  if (!stat(target.c_str(), &buf) )
+    mode = buf.st_mode & 07777;
+
+  const std::string tmp = target + ".new";
+  int fd = open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, mode);
+  if (fd < 0)
+    return false;
+
+  const char *p = data.data();
+  size_t left = data.size();
+  while (left > 0) {
+    ssize_t n = write(fd, p, left);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      break;
+    p += n;
+    left -= n;
+  }
+
+  bool ok = left == 0 && fsync(fd) == 0;
+  ok = close(fd) == 0 && ok;
+  if (ok)
+    ok = rename(tmp.c_str(), target.c_str() ) == 0;
+  if (!ok)
+    unlink(tmp.c_str() );
+  return ok;
+}
+
 Directory::Directory(const char *dir):m_dir(0),
                               m_num_entries(0) {
   if (dir != 0)
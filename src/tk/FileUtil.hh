@@ -33,6 +33,10 @@ namespace FileUtil {
 
   bool copyFile(const char* from, const char* to);
 
+  // writes to a temporary file next to it and renames that over filename,
+  // so readers and crashes never see a half written file
+  bool writeAtomic(const char* filename, const std::string &data);
+
 } // end of File namespace
 
 //  Wrapper class for DIR * routines
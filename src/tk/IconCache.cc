@@ -0,0 +1,111 @@
+// IconCache.cc for Shynebox Window Manager
+
+#include "IconCache.hh"
+
+#include <vector>
+
+namespace tk {
+
+namespace {
+
+std::vector<IconCache *> s_caches;
+
+} // anonymous namespace
+
+bool IconCache::Key::operator < (const Key &o) const {
+  if (pixmap != o.pixmap) return pixmap < o.pixmap;
+  if (mask != o.mask)     return mask < o.mask;
+  if (width != o.width)   return width < o.width;
+  if (height != o.height) return height < o.height;
+  if (depth != o.depth)   return depth < o.depth;
+  return orient < o.orient;
+}
+
+IconCache::IconCache(int screen_num):
+    m_screen_num(screen_num) {
+  if (screen_num >= 0) {
+    if (s_caches.size() <= static_cast<size_t>(screen_num) )
+      s_caches.resize(screen_num + 1, 0);
+    s_caches[screen_num] = this;
+  }
+}
+
+IconCache::~IconCache() {
+  if (m_screen_num >= 0 && static_cast<size_t>(m_screen_num) < s_caches.size()
+      && s_caches[m_screen_num] == this)
+    s_caches[m_screen_num] = 0;
+}
+
+IconCache *IconCache::instance(int screen_num) {
+  if (screen_num < 0 || static_cast<size_t>(screen_num) >= s_caches.size() )
+    return 0;
+  return s_caches[screen_num];
+}
+
+void IconCache::forget(const PixmapWithMask &src) {
+  if (src.pixmap().drawable() == None)
+    return;
+  for (auto it : s_caches)
+    if (it)
+      it->remove(src);
+}
+
+const PixmapWithMask *IconCache::scaled(const PixmapWithMask &src,
+                                        unsigned int width, unsigned int height,
+                                        unsigned int depth, Orientation orient) {
+  if (src.pixmap().drawable() == None || width == 0 || height == 0)
+    return 0;
+
+  const Key key = { src.pixmap().drawable(), src.mask().drawable(),
+                    width, height, depth, orient };
+  auto it = m_icons.find(key);
+  if (it != m_icons.end() )
+    return &it->second;
+
+  PixmapWithMask &icon = m_icons[key];
+  icon.pixmap().copy(key.pixmap, depth, m_screen_num);
+  icon.pixmap().scale(width, height);
+  icon.pixmap().rotate(orient);
+
+  if (key.mask != None) {
+    icon.mask().copy(key.mask, 0, 0);
+    icon.mask().scale(width, height);
+    icon.mask().rotate(orient);
+  }
+
+  return &icon;
+} // scaled
+
+// keys are ordered by source pixmap first
+void IconCache::remove(const PixmapWithMask &src) {
+  const Key first = { src.pixmap().drawable(), 0, 0, 0, 0, ROT0 };
+  auto it = m_icons.lower_bound(first);
+  while (it != m_icons.end() && it->first.pixmap == first.pixmap)
+    it = m_icons.erase(it);
+}
+
+void IconCache::clear() {
+  m_icons.clear();
+}
+
+} // end namespace tk
+
+// Copyright (c) 2023 Shynebox - zlice
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
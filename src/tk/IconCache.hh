@@ -0,0 +1,81 @@
+// IconCache.hh for Shynebox Window Manager
+
+/*
+  Scaled copies of window and menu icons.
+
+  Menu items, iconbar buttons and the window menu button all draw the
+  same icons at a handful of sizes. Scaling goes pixel by pixel, so it
+  is done once per (icon, size, depth, orientation) and the result kept
+  until the icon changes or the style is reloaded.
+
+  Owners of an icon must call IconCache::forget() before they change or
+  free it, the cache is keyed on the X pixmap ids.
+*/
+
+#ifndef TK_ICONCACHE_HH
+#define TK_ICONCACHE_HH
+
+#include "NotCopyable.hh"
+#include "Orientation.hh"
+#include "PixmapWithMask.hh"
+
+#include <map>
+
+namespace tk {
+
+class IconCache: private NotCopyable {
+public:
+  explicit IconCache(int screen_num);
+  ~IconCache();
+
+  // the cache of a screen, 0 if there is none
+  static IconCache *instance(int screen_num);
+  // drop every scaled copy of src on all screens
+  static void forget(const PixmapWithMask &src);
+
+  // src scaled to width x height in depth (0 keeps the depth of src),
+  // 0 if src has no pixmap. owned by the cache, don't hold on to it
+  const PixmapWithMask *scaled(const PixmapWithMask &src,
+                               unsigned int width, unsigned int height,
+                               unsigned int depth,
+                               Orientation orient = ROT0);
+  void clear();
+  size_t size() const { return m_icons.size(); }
+
+private:
+  struct Key {
+    Pixmap pixmap, mask;
+    unsigned int width, height, depth;
+    Orientation orient;
+    bool operator < (const Key &o) const;
+  };
+
+  void remove(const PixmapWithMask &src);
+
+  const int m_screen_num;
+  std::map<Key, PixmapWithMask> m_icons;
+};
+
+} // end namespace tk
+
+#endif // TK_ICONCACHE_HH
+
+// Copyright (c) 2023 Shynebox - zlice
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
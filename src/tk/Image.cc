@@ -1,6 +1,7 @@
 // Image.cc for Shynebox Window Manager
 
 #include "Image.hh"
+#include "PixmapWithMask.hh"
 #include "StringUtil.hh"
 #include "FileUtil.hh"
 
@@ -12,8 +13,14 @@
 #include "ImageImlib2.hh"
 #endif // HAVE_IMLIB2
 
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <atomic>
 #include <list>
 #include <set>
+#include <thread>
+#include <vector>
 
 using std::string;
 using std::list;
@@ -25,6 +32,24 @@ namespace {
 std::map<std::string, tk::ImageBase *> s_image_map;
 std::list<std::string> s_search_paths;
 
+// locateFile results, good until the search paths change
+std::map<std::string, std::string> s_located;
+
+struct Cached {
+  time_t mtime;
+  off_t size;
+  tk::PixmapWithMask *pm;
+  unsigned long used;
+};
+// path and screen
+typedef std::map<std::pair<std::string, int>, Cached> ImageCache;
+ImageCache s_cache;
+unsigned long s_cache_clock = 0;
+
+// pixmaps kept on the server for files no style uses anymore
+const size_t MAX_CACHED = 128;
+const unsigned int MAX_WORKERS = 4;
+
 #ifdef HAVE_IMLIB2
 tk::ImageImlib2 imlib2_loader;
 #endif
@@ -32,6 +57,59 @@ tk::ImageImlib2 imlib2_loader;
 tk::ImageXPM xpm_loader;
 #endif
 
+tk::ImageBase *loaderFor(const string &filename) {
+  string extension(tk::StringUtil::toUpper(tk::StringUtil::findExtension(filename) ) );
+  auto it = s_image_map.find(extension);
+  return it == s_image_map.end() ? 0 : it->second;
+}
+
+bool fileStamp(const string &path, time_t &mtime, off_t &size) {
+  struct stat st;
+  if (stat(path.c_str(), &st) != 0)
+    return false;
+  mtime = st.st_mtime;
+  size = st.st_size;
+  return true;
+}
+
+tk::PixmapWithMask *cached(const string &path, int screen_num,
+                           time_t mtime, off_t size) {
+  auto it = s_cache.find(std::make_pair(path, screen_num) );
+  if (it == s_cache.end() || it->second.mtime != mtime
+      || it->second.size != size)
+    return 0;
+  it->second.used = ++s_cache_clock;
+  return it->second.pm;
+}
+
+void store(const string &path, int screen_num, time_t mtime, off_t size,
+           tk::PixmapWithMask *pm) {
+  Cached &c = s_cache[std::make_pair(path, screen_num)];
+  if (c.pm != 0 && c.pm != pm)
+    delete c.pm;
+  c.mtime = mtime;
+  c.size = size;
+  c.pm = pm;
+  c.used = ++s_cache_clock;
+
+  while (s_cache.size() > MAX_CACHED) {
+    auto oldest = s_cache.begin();
+    for (auto it = s_cache.begin(); it != s_cache.end(); ++it)
+      if (it->second.used < oldest->second.used)
+        oldest = it;
+    delete oldest->second.pm;
+    s_cache.erase(oldest);
+  }
+}
+
+// callers own and modify (scale, release) what load() returns
+tk::PixmapWithMask *copyOf(const tk::PixmapWithMask &pm) {
+  tk::PixmapWithMask *copy = new tk::PixmapWithMask();
+  copy->pixmap().copy(pm.pixmap() );
+  copy->mask().copy(pm.mask() );
+  return copy;
+}
+
 } // end of anonymous namespace
 
 namespace tk {
@@ -40,31 +118,111 @@ PixmapWithMask *Image::load(const string &filename, int screen_num) {
   if (filename.empty() )
     return NULL;
 
-  // determine file ending
-  string extension(StringUtil::toUpper(StringUtil::findExtension(filename) ) );
-
   // valid handle?
-  if (s_image_map.find(extension) == s_image_map.end() )
+  ImageBase *base = loaderFor(filename);
+  if (base == 0)
     return NULL;
 
   string path = locateFile(filename);
-  if (!path.empty() )
-    return s_image_map[extension]->load(path, screen_num);
+  time_t mtime;
+  off_t size;
+  if (path.empty() || !fileStamp(path, mtime, size) )
+    return 0;
+
+  PixmapWithMask *pm = cached(path, screen_num, mtime, size);
+  if (pm == 0) {
+    pm = base->load(path, screen_num);
+    if (pm == 0)
+      return 0;
+    store(path, screen_num, mtime, size, pm);
+  }
 
-  return 0;
+  return copyOf(*pm);
 }
 
+void Image::preload(const set<string> &filenames, const set<int> &screens) {
+  struct Job {
+    string path;
+    time_t mtime;
+    off_t size;
+    ImageBase *base;
+    ImageBase::Decoded *data;
+  };
+  std::vector<Job> jobs;
+  set<string> paths;
+
+  for (auto &name : filenames) {
+    Job job;
+    job.base = loaderFor(name);
+    job.data = 0;
+    if (job.base == 0)
+      continue;
+
+    job.path = locateFile(name);
+    if (job.path.empty() || !paths.insert(job.path).second
+        || !fileStamp(job.path, job.mtime, job.size) )
+      continue;
+
+    for (int screen : screens) {
+      if (cached(job.path, screen, job.mtime, job.size) == 0) {
+        jobs.push_back(job);
+        break;
+      }
+    }
+  }
+
+  if (jobs.empty() )
+    return;
+
+  std::atomic<size_t> next(0);
+  auto work = [&jobs, &next]() {
+    for (size_t i = next++; i < jobs.size(); i = next++)
+      jobs[i].data = jobs[i].base->decode(jobs[i].path);
+  };
+
+  size_t nworkers = std::min<size_t>(jobs.size(),
+                      std::min(MAX_WORKERS, std::thread::hardware_concurrency() ) );
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < nworkers; i++)
+    workers.emplace_back(work);
+  work();
+  for (auto &w : workers)
+    w.join();
+
+  // pixmaps are made here, loaders that can't split do all of it here
+  for (auto &job : jobs) {
+    for (int screen : screens) {
+      if (cached(job.path, screen, job.mtime, job.size) )
+        continue;
+      PixmapWithMask *pm = job.data ? job.base->render(*job.data, screen)
+                                    : job.base->load(job.path, screen);
+      if (pm)
+        store(job.path, screen, job.mtime, job.size, pm);
+    }
+    delete job.data;
+  }
+} // preload
+
 string Image::locateFile(const string &filename) {
+  auto found = s_located.find(filename);
+  if (found != s_located.end() )
+    return found->second;
+
+  string &located = s_located[filename];
   string path = StringUtil::expandFilename(filename);
-  if (FileUtil::isRegularFile(path.c_str() ) )
-    return path;
+  if (FileUtil::isRegularFile(path.c_str() ) ) {
+    located = path;
+    return located;
+  }
   string base = StringUtil::basename(filename);
   for (auto &it : s_search_paths) {
     path = StringUtil::expandFilename(it) + "/" + base;
-    if (FileUtil::isRegularFile(path.c_str() ) )
-      return path;
+    if (FileUtil::isRegularFile(path.c_str() ) ) {
+      located = path;
+      break;
+    }
   }
-  return "";
+  return located;
 }
 
 bool Image::registerType(const string &type, ImageBase &base) {
@@ -98,14 +256,17 @@ void Image::remove(ImageBase &base) {
 
 void Image::addSearchPath(const string &search_path) {
   s_search_paths.push_back(search_path);
+  s_located.clear();
 }
 
 void Image::removeSearchPath(const string &search_path) {
   s_search_paths.remove(search_path);
+  s_located.clear();
 }
 
 void Image::removeAllSearchPaths() {
   s_search_paths.clear();
+  s_located.clear();
 }
 
 } // end namespace tk
@@ -2,6 +2,11 @@
 
 /*
   Loads images to pixmaps
+
+  Decoded images are cached per file and screen until the file changes
+  on disk, load() hands out copies. preload() fills the cache for a
+  whole style at once, decoding in worker threads where the loader can
+  split its work from the server side.
 */
 
 #ifndef TK_IMAGE_HH
@@ -10,6 +15,7 @@
 #include <string>
 #include <list>
 #include <map>
+#include <set>
 
 namespace tk {
 
@@ -33,13 +39,32 @@ namespace Image {
   void removeAllSearchPaths();
   // locates an image in the search path
   std::string locateFile(const std::string &filename);
+  // decodes files for all screens ahead of load()
+  void preload(const std::set<std::string> &filenames,
+               const std::set<int> &screens);
 } // Image namespace
 
 // common interface for all image classes
 class ImageBase {
 public:
+  // file contents before any server resources are made
+  class Decoded {
+  public:
+    virtual ~Decoded() { }
+  };
+
   virtual ~ImageBase() { Image::remove(*this); }
   virtual PixmapWithMask *load(const std::string &name, int screen_num) const = 0;
+  // thread safe first half of load(), 0 if the loader can not split it
+  virtual Decoded *decode(const std::string &name) const {
+    (void) name;
+    return 0;
+  }
+  // second half on the main thread
+  virtual PixmapWithMask *render(const Decoded &data, int screen_num) const {
+    (void) data; (void) screen_num;
+    return 0;
+  }
 };
 
 } // end namespace tk
@@ -7,6 +7,7 @@
 #include "App.hh"
 #include "SimpleCommand.hh"
 #include "I18n.hh"
+#include "ObjectPool.hh"
 
 #ifdef HAVE_SYS_TYPES_H
 #include <sys/types.h>
@@ -122,6 +123,8 @@ void allocateUnallocatedColors(std::vector<XColor> colors, Display* dpy,
 } // end anonymous namespace
 
 struct ImageControl::Cache {
+  TK_POOLED(Cache)
+
   Pixmap pixmap;
   Pixmap texture_pixmap;
   Orientation orient;
@@ -132,7 +135,8 @@ struct ImageControl::Cache {
 ImageControl::ImageControl(int screen_num,
                            int cpc, unsigned long cache_timeout, unsigned long cmax):
     m_colors_per_channel(cpc),
-    m_screen_num(screen_num) {
+    m_screen_num(screen_num),
+    m_icon_cache(screen_num) {
   Display *disp = tk::App::instance()->display();
 
   m_screen_depth = DefaultDepth(disp, screen_num);
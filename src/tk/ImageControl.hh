@@ -7,6 +7,7 @@
 #ifndef TK_IMAGECONTROL_HH
 #define TK_IMAGECONTROL_HH
 
+#include "IconCache.hh"
 #include "Orientation.hh"
 #include "Timer.hh"
 #include "NotCopyable.hh"
@@ -33,6 +34,7 @@ public:
   const XColor* colors() const { return &m_colors[0]; }
   int screenNumber() const { return m_screen_num; }
   Visual *visual() const { return m_visual; }
+  IconCache &iconCache() { return m_icon_cache; }
 
   // Render to pixmap
   Pixmap renderImage(unsigned int width, unsigned int height,
@@ -84,6 +86,8 @@ private:
 
   mutable CacheList cache;
   unsigned long cache_max;
+
+  IconCache m_icon_cache;
 };
 
 } // end namespace tk
@@ -7,6 +7,18 @@
 
 #include <X11/xpm.h>
 
+namespace {
+
+// parsed file, colors are only allocated in render()
+class DecodedXPM: public tk::ImageBase::Decoded {
+public:
+  explicit DecodedXPM(const XpmImage &img):image(img) { }
+  ~DecodedXPM() { XpmFreeXpmImage(&image); }
+  XpmImage image;
+};
+
+} // anonymous namespace
+
 namespace tk {
 
 ImageXPM::ImageXPM() {
@@ -29,6 +41,27 @@ PixmapWithMask *ImageXPM::load(const std::string &filename, int screen_num) cons
     return 0;
 }
 
+ImageBase::Decoded *ImageXPM::decode(const std::string &filename) const {
+  XpmImage image;
+  if (XpmReadFileToXpmImage(const_cast<char *>(filename.c_str() ),
+                            &image, 0) != XpmSuccess)
+    return 0;
+  return new DecodedXPM(image);
+}
+
+PixmapWithMask *ImageXPM::render(const Decoded &data, int screen_num) const {
+  XpmImage &image = const_cast<XpmImage &>(
+                      static_cast<const DecodedXPM &>(data).image);
+  XpmAttributes xpm_attr;
+  xpm_attr.valuemask = 0;
+  Display *dpy = tk::App::instance()->display();
+  Pixmap pm = 0, mask = 0;
+  if (XpmCreatePixmapFromXpmImage(dpy, RootWindow(dpy, screen_num), &image,
+                                  &pm, &mask, &xpm_attr) == XpmSuccess)
+    return new PixmapWithMask(pm, mask);
+  return 0;
+}
+
 } // end namespace tk
 
 // Copyright (c) 2023 Shynebox - zlice
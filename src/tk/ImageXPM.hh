@@ -14,6 +14,8 @@ class ImageXPM: public ImageBase {
 public:
   ImageXPM();
   PixmapWithMask *load(const std::string &filename, int screen_num) const;
+  Decoded *decode(const std::string &filename) const;
+  PixmapWithMask *render(const Decoded &data, int screen_num) const;
 };
 
 } // end namespace tk
@@ -173,6 +173,14 @@ void KeyUtil::ungrabButtons(Window win) {
   XUngrabButton(display, AnyButton, AnyModifier, win);
 }
 
+void KeyUtil::ungrabKey(unsigned int key, unsigned int mod, Window win) {
+  XUngrabKey(App::instance()->display(), key, mod, win);
+}
+
+void KeyUtil::ungrabButton(unsigned int button, unsigned int mod, Window win) {
+  XUngrabButton(App::instance()->display(), button, mod, win);
+}
+
 unsigned int KeyUtil::keycodeToModmask(unsigned int keycode) {
   XModifierKeymap *modmap = instance().m_modmap;
 
@@ -33,6 +33,9 @@ public:
   // ungrabs all keys
   static void ungrabKeys(Window win);
   static void ungrabButtons(Window win);
+  // ungrab a single combination
+  static void ungrabKey(unsigned int key, unsigned int mod, Window win);
+  static void ungrabButton(unsigned int button, unsigned int mod, Window win);
 
   // strip out modifiers we want to ignore
   unsigned int cleanMods(unsigned int mods) {
@@ -5,6 +5,7 @@
 #include "MenuTheme.hh"
 #include "App.hh"
 #include "Command.hh"
+#include "IconCache.hh"
 #include "Image.hh"
 #include "GContext.hh"
 #include "PixmapWithMask.hh"
@@ -19,7 +20,7 @@ namespace tk {
 
 MenuItem::~MenuItem() {
   if (m_icon) {
-    delete m_icon->pixmap;
+    dropIcon();
     delete m_icon;
   }
   if (m_command != 0 && !m_command->get_is_shared() )
@@ -99,50 +100,30 @@ void MenuItem::draw(SbDrawable &draw,
 
   // Icon
   if (draw_background) {
-    if (icon() != 0) {
-      // copy pixmap, so we don't resize the original
-      SbPixmap tmp_pixmap, tmp_mask;
-      tmp_pixmap.copy(icon()->pixmap() );
-      tmp_mask.copy(icon()->mask() );
-
-      // scale pixmap to right size
-      if ((h - (2*bevel) ) != static_cast<int>(tmp_pixmap.height() ) ) {
-        int scale_size = h - 2*bevel;
-        if (scale_size > 0) {
-            tmp_pixmap.scale(scale_size, scale_size);
-            tmp_mask.scale(scale_size, scale_size);
-        }
-      }
-
-      if (tmp_pixmap.drawable() != 0) {
+    if (icon() != 0 && icon()->pixmap().drawable() != 0) {
+      // scale pixmap to right size, the cache keeps it for the next draw
+      unsigned int size = icon()->height();
+      if (h - 2*bevel > 0)
+        size = h - 2*bevel;
+
+      IconCache *cache = IconCache::instance(theme->screenNum() );
+      const PixmapWithMask *pm = 0;
+      if (cache)
+        pm = cache->scaled(*icon(), size, size, draw.depth() );
+
+      if (pm && pm->pixmap().drawable() != 0) {
         GC gc = theme->frameTextGC().gc();
         int icon_x = x + bevel;
         int icon_y = y + bevel;
         // enable clip mask
-        XSetClipMask(disp, gc, tmp_mask.drawable() );
+        XSetClipMask(disp, gc, pm->mask().drawable() );
         XSetClipOrigin(disp, gc, icon_x, icon_y);
 
-        if (draw.depth() == tmp_pixmap.depth() ) {
-          draw.copyArea(tmp_pixmap.drawable(),
-                        gc,
-                        0, 0,
-                        icon_x, icon_y,
-                        tmp_pixmap.width(), tmp_pixmap.height() );
-        } else {
-          XGCValues backup;
-          XGetGCValues(draw.display(), gc, GCForeground|GCBackground,
-                       &backup);
-          XSetForeground(draw.display(), gc,
-                         Color("black", theme->screenNum() ).pixel() );
-          XSetBackground(draw.display(), gc,
-                         Color("white", theme->screenNum() ).pixel() );
-          XCopyPlane(draw.display(), tmp_pixmap.drawable(),
-                     draw.drawable(), gc,
-                     0, 0, tmp_pixmap.width(), tmp_pixmap.height(),
-                     icon_x, icon_y, 1);
-          XSetForeground(draw.display(), gc, backup.foreground);
-          XSetBackground(draw.display(), gc, backup.background);
-        } // if draw.depth check
+        draw.copyArea(pm->pixmap().drawable(),
+                      gc,
+                      0, 0,
+                      icon_x, icon_y,
+                      pm->width(), pm->height() );
         XSetClipMask(disp, gc, None); // restore clip mask
       } // if drawable
     } // if icon
@@ -302,7 +283,7 @@ void MenuItem::draw(SbDrawable &draw,
 void MenuItem::setIcon(const std::string &filename, int screen_num) {
   if (filename.empty() ) {
     if (m_icon) {
-      delete m_icon->pixmap;
+      dropIcon();
       delete m_icon;
     }
     m_icon = 0;
@@ -313,8 +294,7 @@ void MenuItem::setIcon(const std::string &filename, int screen_num) {
     m_icon = new Icon;
 
   m_icon->filename = tk::StringUtil::expandFilename(filename);
-  if (m_icon->pixmap)
-    delete m_icon->pixmap;
+  dropIcon();
   m_icon->pixmap = Image::load(m_icon->filename.c_str(), screen_num);
 }
 
@@ -338,11 +318,18 @@ void MenuItem::updateTheme(const tk::ThemeProxy<MenuTheme> &theme) {
   if (m_icon == 0)
     return;
 
-  if (m_icon->pixmap)
-    delete m_icon->pixmap;
+  dropIcon();
   m_icon->pixmap = Image::load(m_icon->filename.c_str(), theme->screenNum() );
 }
 
+void MenuItem::dropIcon() {
+  if (m_icon->pixmap) {
+    IconCache::forget(*m_icon->pixmap);
+    delete m_icon->pixmap;
+    m_icon->pixmap = 0;
+  }
+}
+
 void MenuItem::showSubmenu() {
   if (submenu() != 0)
     submenu()->show();
@@ -134,6 +134,9 @@ public:
   Menu *menu() { return m_menu; }
 
 private:
+  // frees the loaded icon and its scaled copies
+  void dropIcon();
+
   BiDiString m_label;           // label of this item
   Menu *m_menu = 0;             // the menu we live in
   Menu *m_submenu = 0;          // a submenu, 0 if we don't have one
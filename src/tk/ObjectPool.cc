@@ -0,0 +1,141 @@
+// ObjectPool.cc for Shynebox Window Manager
+
+#include "ObjectPool.hh"
+
+#include <algorithm>
+#include <new>
+
+namespace {
+
+size_t alignSlot(size_t size) {
+  const size_t align = alignof(std::max_align_t);
+  return ((size + align - 1) / align) * align;
+}
+
+} // anonymous namespace
+
+namespace tk {
+
+ObjectPool::ObjectPool(size_t size, size_t per_slab):
+    m_obj_size(size),
+    m_slot_size(alignSlot(size < sizeof(Free) ? sizeof(Free) : size) ),
+    m_per_slab(per_slab ? per_slab : 1) { }
+
+ObjectPool::~ObjectPool() {
+  for (auto &slab : m_slabs)
+    ::operator delete(slab.mem);
+}
+
+ObjectPool::Slab *ObjectPool::slabOf(void *obj) {
+  char *p = static_cast<char *>(obj);
+  auto it = std::upper_bound(m_slabs.begin(), m_slabs.end(), p,
+                [](char *a, const Slab &s) { return a < s.mem; });
+  if (it == m_slabs.begin() )
+    return 0;
+  --it;
+  if (p >= it->mem + m_slot_size * m_per_slab)
+    return 0;
+  return &*it;
+}
+
+// keep filling the last slab while it has room, else take the fullest
+// one that isn't full. only grow when every slab is full
+ObjectPool::Slab *ObjectPool::pickSlab() {
+  if (m_current) {
+    Slab *cur = slabOf(m_current);
+    if (cur && cur->free)
+      return cur;
+  }
+
+  Slab *best = 0;
+  for (auto &slab : m_slabs)
+    if (slab.free && (best == 0 || slab.used > best->used) )
+      best = &slab;
+
+  return best ? best : grow();
+}
+
+ObjectPool::Slab *ObjectPool::grow() {
+  Slab slab;
+  slab.mem = static_cast<char *>(::operator new(m_slot_size * m_per_slab) );
+  slab.free = 0;
+  slab.used = 0;
+
+  // hand out from the front of the slab first
+  for (size_t i = m_per_slab; i > 0; i--) {
+    Free *f = reinterpret_cast<Free *>(slab.mem + (i - 1) * m_slot_size);
+    f->next = slab.free;
+    slab.free = f;
+  }
+
+  auto it = std::upper_bound(m_slabs.begin(), m_slabs.end(), slab.mem,
+                [](char *a, const Slab &s) { return a < s.mem; });
+  m_empty++;
+  return &*m_slabs.insert(it, slab);
+}
+
+void ObjectPool::drop(Slab *slab) {
+  if (m_current == slab->mem)
+    m_current = 0;
+  ::operator delete(slab->mem);
+  m_slabs.erase(m_slabs.begin() + (slab - m_slabs.data() ) );
+  m_empty--;
+}
+
+void *ObjectPool::alloc(size_t size) {
+  if (size != m_obj_size)
+    return ::operator new(size);
+
+  Slab *slab = pickSlab();
+  Free *f = slab->free;
+  slab->free = f->next;
+  if (slab->used++ == 0)
+    m_empty--;
+  m_current = slab->mem;
+
+  if (++m_used > m_peak)
+    m_peak = m_used;
+  return f;
+}
+
+void ObjectPool::release(void *obj, size_t size) {
+  if (obj == 0)
+    return;
+
+  Slab *slab = size == m_obj_size ? slabOf(obj) : 0;
+  if (slab == 0) {
+    ::operator delete(obj);
+    return;
+  }
+
+  Free *f = static_cast<Free *>(obj);
+  f->next = slab->free;
+  slab->free = f;
+  m_used--;
+
+  // one empty slab stays as a spare, the rest go back right away
+  if (--slab->used == 0 && ++m_empty > 1)
+    drop(slab);
+}
+
+} // namespace tk
+
+// Copyright (c) 2023 Shynebox - zlice
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
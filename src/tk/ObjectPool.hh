@@ -0,0 +1,98 @@
+// ObjectPool.hh for Shynebox Window Manager
+
+/*
+  Slab allocator for objects that come and go with client windows.
+
+  Windows, clients, their title buttons, tabs/icon buttons and pixmap
+  cache entries are created and deleted in bursts. Giving each class its
+  own slabs keeps them out of the general heap, so opening and closing
+  a few hundred windows does not leave it fragmented.
+
+  Objects can't be moved, so slabs are kept dense instead: new objects
+  go into the fullest slab that has room, which lets the emptier ones
+  drain. A slab is handed back as soon as it is empty, only one empty
+  slab is kept around so a burst of new/delete doesn't thrash.
+
+  Pools are per class and shared by all screens, operator new has no
+  screen to go by.
+
+  Use TK_POOLED(Class) in the public part of a class. Derived classes
+  that do not use it themselves fall back to the normal heap.
+*/
+
+#ifndef TK_OBJECTPOOL_HH
+#define TK_OBJECTPOOL_HH
+
+#include <cstddef>
+#include <vector>
+
+namespace tk {
+
+class ObjectPool {
+public:
+  explicit ObjectPool(size_t size, size_t per_slab = 32);
+  ~ObjectPool();
+
+  void *alloc(size_t size);
+  void release(void *obj, size_t size);
+
+  size_t used() const  { return m_used; }
+  size_t peak() const  { return m_peak; }
+  size_t slabs() const { return m_slabs.size(); }
+
+private:
+  ObjectPool(const ObjectPool &);
+  ObjectPool &operator=(const ObjectPool &);
+
+  struct Free { Free *next; };
+  struct Slab {
+    char *mem;
+    Free *free;
+    size_t used;
+  };
+
+  Slab *slabOf(void *obj);
+  Slab *pickSlab();
+  Slab *grow();
+  void drop(Slab *slab);
+
+  const size_t m_obj_size;  // sizeof(Class), anything else skips the pool
+  const size_t m_slot_size; // aligned
+  const size_t m_per_slab;
+  size_t m_used = 0, m_peak = 0;
+  std::vector<Slab> m_slabs; // sorted by address for slabOf()
+  char *m_current = 0;       // slab the last alloc came from
+  size_t m_empty = 0;        // slabs with nothing in use
+};
+
+} // namespace tk
+
+#define TK_POOLED(Class) \
+  static tk::ObjectPool &pool() { \
+    static tk::ObjectPool s_pool(sizeof(Class) ); \
+    return s_pool; \
+  } \
+  static void *operator new(size_t size) { return pool().alloc(size); } \
+  static void operator delete(void *obj, size_t size) { pool().release(obj, size); }
+
+#endif // TK_OBJECTPOOL_HH
+
+// Copyright (c) 2023 Shynebox - zlice
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
@@ -2,10 +2,29 @@
 
 #include "RegExp.hh"
 
+#include <cctype>
+#include <cstring>
 #include <iostream>
 
 using std::string;
 
+namespace {
+
+// characters that mean something in an extended regexp
+bool isSpecial(char c) {
+  return strchr(".[]()*+?{}|^$\\", c) != 0;
+}
+
+// an escaped '.' and so on only stands for itself
+bool isEscape(const string &str, size_t pos) {
+  size_t n = 0;
+  while (pos > 0 && str[--pos] == '\\')
+    n++;
+  return n % 2 == 1;
+}
+
+} // anonymous namespace
+
 namespace tk {
 
 // full_match is to say if we match on this regexp using the full string
@@ -13,6 +32,9 @@ namespace tk {
 RegExp::RegExp(const string &str, bool full_match):
 #ifdef USE_REGEXP
     m_regex(0) {
+  if (parseLiterals(str, full_match) )
+    return;
+
   string match;
   if (full_match) {
     match = "^";
@@ -43,7 +65,109 @@ RegExp::~RegExp() {
 #endif // USE_REGEXP
 } // RegExp class destroy
 
+// split 'a|b|c' (optionally in one pair of parentheses) into alternatives
+// that each have to be a literal, else it's left to regcomp.
+// full_match wraps the pattern in ^ and $, without the parentheses those
+// only bind to the first and last alternative: '^a|b|c$'
+bool RegExp::parseLiterals(const string &str, bool full_match) {
+  string body = str;
+  bool grouped = false;
+  if (body.size() > 1 && body.front() == '(' && body.back() == ')'
+      && !isEscape(body, body.size() - 1) ) {
+    body = body.substr(1, body.size() - 2);
+    grouped = true;
+  }
+
+  size_t start = 0;
+  for (size_t i = 0; i <= body.size(); i++) {
+    if (i < body.size() && (body[i] != '|' || isEscape(body, i) ) )
+      continue;
+
+    // 'a||b' and 'a|' are left to the regex engine
+    if (i == start && body.size() > 0) {
+      m_literals.clear();
+      return false;
+    }
+    bool head = full_match && (grouped || start == 0);
+    bool tail = full_match && (grouped || i == body.size() );
+    if (!parseLiteral(body.substr(start, i - start), head, tail) ) {
+      m_literals.clear();
+      return false;
+    }
+    start = i + 1;
+  }
+  return true;
+}
+
+// literal text with an optional ^ or .* in front and $ or .* at the end
+bool RegExp::parseLiteral(string alt, bool head, bool tail) {
+  bool any_head = !head, any_tail = !tail;
+
+  if (alt.compare(0, 1, "^") == 0) {
+    any_head = false;
+    alt.erase(0, 1);
+  } else if (alt.compare(0, 2, ".*") == 0) {
+    any_head = true;
+    alt.erase(0, 2);
+  }
+
+  size_t len = alt.size();
+  if (len >= 1 && alt[len - 1] == '$' && !isEscape(alt, len - 1) ) {
+    any_tail = false;
+    alt.erase(len - 1);
+  } else if (len >= 2 && alt.compare(len - 2, 2, ".*") == 0
+             && !isEscape(alt, len - 2) ) {
+    any_tail = true;
+    alt.erase(len - 2);
+  }
+
+  Literal lit;
+  for (size_t i = 0; i < alt.size(); i++) {
+    if (alt[i] == '\\') {
+      // only escaped punctuation is plain, '\w' and such aren't.
+      // glibc reads \< \> \` \' as word and buffer anchors
+      if (++i == alt.size() || !ispunct((unsigned char)alt[i])
+          || strchr("<>`'", alt[i]) )
+        return false;
+    } else if (isSpecial(alt[i]) )
+      return false;
+    lit.str += alt[i];
+  }
+
+  if (any_head && any_tail)
+    lit.kind = lit.str.empty() ? Literal::ANY : Literal::CONTAINS;
+  else if (any_head)
+    lit.kind = Literal::SUFFIX;
+  else if (any_tail)
+    lit.kind = Literal::PREFIX;
+  else
+    lit.kind = Literal::EXACT;
+
+  m_literals.push_back(lit);
+  return true;
+}
+
+bool RegExp::Literal::match(const string &in) const {
+  switch (kind) {
+  case EXACT:
+    return in == str;
+  case PREFIX:
+    return in.size() >= str.size() && in.compare(0, str.size(), str) == 0;
+  case SUFFIX:
+    return in.size() >= str.size()
+           && in.compare(in.size() - str.size(), str.size(), str) == 0;
+  case CONTAINS:
+    return in.find(str) != string::npos;
+  case ANY:
+    break;
+  }
+  return true;
+}
+
 bool RegExp::match(const string &str) const {
+  for (auto &lit : m_literals)
+    if (lit.match(str) )
+      return true;
 #ifdef USE_REGEXP
   if (m_regex)
     return regexec(m_regex, str.c_str(), 0, 0, 0) == 0;
@@ -56,7 +180,7 @@ bool RegExp::match(const string &str) const {
 
 bool RegExp::error() const {
 #ifdef USE_REGEXP
-  return m_regex == 0;
+  return m_regex == 0 && m_literals.empty();
 #else
   return m_str == "";
 #endif // USE_REGEXP
@@ -3,6 +3,10 @@
 /*
   Uses C library regex compares.
   If USE_REGEXP isn't defined, then we match just using simple string equality.
+
+  Most patterns in apps and keys files are plain names, maybe with a
+  leading or trailing .* or a few of them joined with |. Those are
+  matched with plain string compares and never reach the regex engine.
 */
 
 #ifndef TK_REGEXP_HH
@@ -11,6 +15,7 @@
 #include "NotCopyable.hh"
 
 #include <string>
+#include <vector>
 
 #ifdef USE_REGEXP
 #include <sys/types.h>
@@ -28,7 +33,21 @@ public:
 
   bool error() const;
 
+  // true if no regex engine is needed for this one
+  bool isLiteral() const { return !m_literals.empty(); }
+
 private:
+  struct Literal {
+    enum Kind { EXACT, PREFIX, SUFFIX, CONTAINS, ANY };
+    Kind kind;
+    std::string str;
+    bool match(const std::string &str) const;
+  };
+  bool parseLiterals(const std::string &str, bool full_match);
+  // head/tail: alternative is anchored at the start/end
+  bool parseLiteral(std::string alt, bool head, bool tail);
+
+  std::vector<Literal> m_literals; // alternatives, empty for real regexps
 #ifdef USE_REGEXP
   regex_t* m_regex;
 #else // notdef USE_REGEXP
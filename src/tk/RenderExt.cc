@@ -0,0 +1,176 @@
+// RenderExt.cc for Shynebox Window Manager
+
+#include "RenderExt.hh"
+
+#include "App.hh"
+#include "GContext.hh"
+#include "SbPixmap.hh"
+#include "TextUtils.hh"
+
+#ifdef HAVE_XRENDER
+#include <X11/extensions/Xrender.h>
+#endif // HAVE_XRENDER
+
+namespace {
+
+#ifdef HAVE_XRENDER
+int s_have_render = -1;
+
+// only formats where a copy gives back the same pixel values, colormap
+// visuals go through a color lookup
+XRenderPictFormat *findFormat(Display *disp, unsigned int depth) {
+  if (s_have_render < 0) {
+    int event_base, error_base;
+    s_have_render = XRenderQueryExtension(disp, &event_base, &error_base);
+  }
+  if (!s_have_render)
+    return 0;
+
+  if (depth == 1)
+    return XRenderFindStandardFormat(disp, PictStandardA1);
+
+  for (int s = 0; s < ScreenCount(disp); s++) {
+    Visual *vis = DefaultVisual(disp, s);
+    if (DefaultDepth(disp, s) == (int)depth && vis->c_class == TrueColor)
+      return XRenderFindVisualFormat(disp, vis);
+  }
+
+  if (depth == 32)
+    return XRenderFindStandardFormat(disp, PictStandardARGB32);
+  return 0;
+}
+
+void composite(Display *disp, XRenderPictFormat *fmt,
+               Drawable src, unsigned long mask,
+               XRenderPictureAttributes *pa, XTransform *transform,
+               Drawable dst, int x, int y, unsigned int w, unsigned int h) {
+  Picture src_pic = XRenderCreatePicture(disp, src, fmt, mask, pa);
+  Picture dst_pic = XRenderCreatePicture(disp, dst, fmt, 0, 0);
+  if (transform)
+    XRenderSetPictureTransform(disp, src_pic, transform);
+
+  XRenderComposite(disp, PictOpSrc, src_pic, None, dst_pic,
+                   0, 0, 0, 0, x, y, w, h);
+
+  XRenderFreePicture(disp, dst_pic);
+  XRenderFreePicture(disp, src_pic);
+}
+#endif // HAVE_XRENDER
+
+} // anonymous namespace
+
+namespace tk {
+
+namespace RenderExt {
+
+bool usable(unsigned int depth) {
+#ifdef HAVE_XRENDER
+  return findFormat(App::instance()->display(), depth) != 0;
+#else
+  (void) depth;
+  return false;
+#endif // HAVE_XRENDER
+}
+
+bool tile(Drawable src, int src_x, int src_y,
+          unsigned int src_w, unsigned int src_h,
+          Drawable dst, int x, int y, unsigned int w, unsigned int h,
+          unsigned int depth) {
+#ifdef HAVE_XRENDER
+  Display *disp = App::instance()->display();
+  XRenderPictFormat *fmt = findFormat(disp, depth);
+  if (fmt == 0 || src_w == 0 || src_h == 0)
+    return false;
+  if (w == 0 || h == 0)
+    return true;
+
+  // repeat is for whole pictures, the part gets its own pixmap
+  SbPixmap part(src, src_w, src_h, depth);
+  if (part.drawable() == None)
+    return false;
+  GContext gc(part);
+  part.copyArea(src, gc.gc(), src_x, src_y, 0, 0, src_w, src_h);
+
+  XRenderPictureAttributes pa;
+  pa.repeat = RepeatNormal;
+  composite(disp, fmt, part.drawable(), CPRepeat, &pa, 0, dst, x, y, w, h);
+  return true;
+#else
+  (void) src; (void) src_x; (void) src_y; (void) src_w; (void) src_h;
+  (void) dst; (void) x; (void) y; (void) w; (void) h; (void) depth;
+  return false;
+#endif // HAVE_XRENDER
+}
+
+bool rotate(Drawable src, unsigned int w, unsigned int h,
+            Drawable dst, Orientation orient, unsigned int depth) {
+#ifdef HAVE_XRENDER
+  Display *disp = App::instance()->display();
+  XRenderPictFormat *fmt = findFormat(disp, depth);
+  if (fmt == 0)
+    return false;
+
+  unsigned int neww = w, newh = h;
+  translateSize(orient, neww, newh);
+
+  // maps dst pixel centers to src pixel centers, so the default
+  // nearest filter takes exactly one pixel
+  //   ROT90   src(x, y) = dst(neww - 1 - y, x)
+  //   ROT180  src(x, y) = dst(w - 1 - x, h - 1 - y)
+  //   ROT270  src(x, y) = dst(y, newh - 1 - x)
+  double m[2][3] = { { 1, 0, 0 }, { 0, 1, 0 } };
+  switch (orient) {
+  case ROT90:
+    m[0][0] = 0; m[0][1] = 1;  m[0][2] = 0;
+    m[1][0] = -1; m[1][1] = 0; m[1][2] = neww;
+    break;
+  case ROT180:
+    m[0][0] = -1; m[0][2] = w;
+    m[1][1] = -1; m[1][2] = h;
+    break;
+  case ROT270:
+    m[0][0] = 0; m[0][1] = -1; m[0][2] = newh;
+    m[1][0] = 1; m[1][1] = 0;  m[1][2] = 0;
+    break;
+  default:
+    break;
+  }
+
+  XTransform transform;
+  for (int r = 0; r < 2; r++)
+    for (int c = 0; c < 3; c++)
+      transform.matrix[r][c] = XDoubleToFixed(m[r][c]);
+  transform.matrix[2][0] = transform.matrix[2][1] = 0;
+  transform.matrix[2][2] = XDoubleToFixed(1);
+
+  composite(disp, fmt, src, 0, 0, &transform, dst, 0, 0, neww, newh);
+  return true;
+#else
+  (void) src; (void) w; (void) h; (void) dst; (void) orient; (void) depth;
+  return false;
+#endif // HAVE_XRENDER
+}
+
+} // namespace RenderExt
+
+} // namespace tk
+
+// Copyright (c) 2023 Shynebox - zlice
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
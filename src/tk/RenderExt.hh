@@ -0,0 +1,60 @@
+// RenderExt.hh for Shynebox Window Manager
+
+/*
+  Pixmap work done by the server through the XRender extension.
+
+  TextureRender and SbPixmap use it, when the server has it, to repeat
+  parts of a texture and to turn pixmaps for vertical toolbars, instead
+  of pulling pixels over to us and sending them back. The results match
+  the client side code, which is still used without the extension.
+*/
+
+#ifndef TK_RENDEREXT_HH
+#define TK_RENDEREXT_HH
+
+#include "Orientation.hh"
+
+#include <X11/Xlib.h>
+
+namespace tk {
+
+namespace RenderExt {
+
+// XRender is there and pixmaps of depth can be copied exactly
+bool usable(unsigned int depth);
+
+// fills an area of dst with src_w x src_h of src, repeated
+bool tile(Drawable src, int src_x, int src_y,
+          unsigned int src_w, unsigned int src_h,
+          Drawable dst, int x, int y, unsigned int w, unsigned int h,
+          unsigned int depth);
+
+// src is w x h, dst the size after translateSize(orient)
+bool rotate(Drawable src, unsigned int w, unsigned int h,
+            Drawable dst, Orientation orient, unsigned int depth);
+
+} // namespace RenderExt
+
+} // namespace tk
+
+#endif // TK_RENDEREXT_HH
+
+// Copyright (c) 2023 Shynebox - zlice
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
@@ -3,11 +3,13 @@
 #include "SbPixmap.hh"
 #include "App.hh"
 #include "GContext.hh"
+#include "RenderExt.hh"
 #include "SbWindow.hh"
 #include "TextUtils.hh"
 
 #include <X11/Xutil.h>
 #include <X11/Xatom.h>
+#include <cstdlib>
 #include <iostream>
 #include <vector>
 #ifdef HAVE_CSTRING
@@ -182,7 +184,7 @@ void SbPixmap::copy(Pixmap pm, unsigned int depth, int screen_num) {
 }
 
 void SbPixmap::rotate(tk::Orientation orient) {
-  if (orient == ROT0)
+  if (orient == ROT0 || drawable() == 0)
     return;
 
   unsigned int oldw = width(), oldh = height();
@@ -192,42 +194,58 @@ void SbPixmap::rotate(tk::Orientation orient) {
   // reverse height/width for new pixmap
   SbPixmap new_pm(drawable(), neww, newh, depth() );
 
-  // width|height could be 0. this happens (for example) if
-  // the systemtray-tool is ROT90. in that case 'src_image'
-  // becomes NULL and caused a SIGSEV upon XDestroyImage()
-  // TODO: catch dimensions with '0' earlier?
-  //
-  // make an image copy
-  XImage *src_image = XGetImage(display(), drawable(),
-                                0, 0, // pos
-                                oldw, oldh, // size
-                                ~0, // plane mask
-                                ZPixmap); // format
-
-  if (src_image) {
-    GContext gc(drawable() );
-
-    if (orient >= ROT90) { // - vert need to flip x and y
-      // set start, end and direction based on rotation
-      // NOTE that startx etc are in the direction of the OLD pixmap
-      unsigned int startx = neww-1, starty = 0;
-      int dirx = -1, diry = 1;
-      if (orient == ROT270) {
-        std::swap(startx, starty);
-        std::swap(dirx, diry);
-      }
+  if (!RenderExt::rotate(drawable(), oldw, oldh, new_pm.drawable(),
+                         orient, depth() ) ) {
+    // width|height could be 0. this happens (for example) if
+    // the systemtray-tool is ROT90. in that case 'src_image'
+    // becomes NULL and caused a SIGSEV upon XDestroyImage()
+    // TODO: catch dimensions with '0' earlier?
+    //
+    // make an image copy
+    XImage *src_image = XGetImage(display(), drawable(),
+                                  0, 0, // pos
+                                  oldw, oldh, // size
+                                  ~0, // plane mask
+                                  ZPixmap); // format
+    XImage *dest_image = 0;
+    if (src_image) {
+      dest_image = XCreateImage(display(), 0, depth(), ZPixmap, 0, 0,
+                                neww, newh, src_image->bitmap_pad, 0);
+      if (dest_image)
+        dest_image->data = static_cast<char *>(
+                    malloc(dest_image->bytes_per_line * newh) );
+    }
 
-      // copy new area
-      unsigned int srcx, srcy, destx, desty;
-      for (srcy = 0, destx = startx; srcy < oldh; ++srcy, destx+=dirx) {
-        for (srcx = 0, desty = starty; srcx < oldw; ++srcx, desty+=diry) {
-          gc.setForeground(XGetPixel(src_image, srcx, srcy) );
-          XDrawPoint(display(), new_pm.drawable(), gc.gc(), destx, desty);
+    if (dest_image && dest_image->data) {
+      unsigned int srcx, srcy;
+      for (srcy = 0; srcy < oldh; ++srcy) {
+        for (srcx = 0; srcx < oldw; ++srcx) {
+          int destx = srcx, desty = srcy;
+          if (orient == ROT90) {
+            destx = neww - 1 - srcy;
+            desty = srcx;
+          } else if (orient == ROT270) {
+            destx = srcy;
+            desty = newh - 1 - srcx;
+          } else { // ROT180
+            destx = oldw - 1 - srcx;
+            desty = oldh - 1 - srcy;
+          }
+          XPutPixel(dest_image, destx, desty,
+                    XGetPixel(src_image, srcx, srcy) );
         }
       }
-    } // if vertical
-    XDestroyImage(src_image);
-  } // if src_image
+
+      GContext gc(drawable() );
+      XPutImage(display(), new_pm.drawable(), gc.gc(), dest_image,
+                0, 0, 0, 0, neww, newh);
+    }
+
+    if (dest_image)
+      XDestroyImage(dest_image); // frees data as well
+    if (src_image)
+      XDestroyImage(src_image);
+  }
 
   // free old pixmap and set new from new_pm
   free();
@@ -251,10 +269,22 @@ void SbPixmap::scale(unsigned int dest_width, unsigned int dest_height) {
   if (src_image == 0)
     return;
 
-  // create new pixmap with dest size
-  SbPixmap new_pm(drawable(), dest_width, dest_height, depth() );
+  // scale into a client side image and send it in one go
+  XImage *dest_image = XCreateImage(display(), 0, depth(), ZPixmap, 0, 0,
+                                    dest_width, dest_height,
+                                    src_image->bitmap_pad, 0);
+  if (dest_image == 0) {
+    XDestroyImage(src_image);
+    return;
+  }
+  dest_image->data = static_cast<char *>(
+                  calloc(dest_image->bytes_per_line, dest_height) );
+  if (dest_image->data == 0) {
+    XDestroyImage(dest_image);
+    XDestroyImage(src_image);
+    return;
+  }
 
-  GContext gc(drawable() );
   // calc zoom
   float zoom_x = static_cast<float>(width() )/static_cast<float>(dest_width);
   float zoom_y = static_cast<float>(height() )/static_cast<float>(dest_height);
@@ -264,15 +294,22 @@ void SbPixmap::scale(unsigned int dest_width, unsigned int dest_height) {
   for (unsigned int tx=0; tx < dest_width; ++tx, src_x += zoom_x) {
     src_y = 0;
     for (unsigned int ty=0; ty < dest_height; ++ty, src_y += zoom_y) {
-      gc.setForeground(XGetPixel(src_image,
-                       static_cast<int>(src_x),
-                       static_cast<int>(src_y) ) );
-      XDrawPoint(display(), new_pm.drawable(), gc.gc(), tx, ty);
+      XPutPixel(dest_image, tx, ty,
+                XGetPixel(src_image,
+                          static_cast<int>(src_x),
+                          static_cast<int>(src_y) ) );
     }
   } // for dest_width
 
   XDestroyImage(src_image);
 
+  // create new pixmap with dest size
+  SbPixmap new_pm(drawable(), dest_width, dest_height, depth() );
+  GContext gc(drawable() );
+  XPutImage(display(), new_pm.drawable(), gc.gc(), dest_image,
+            0, 0, 0, 0, dest_width, dest_height);
+  XDestroyImage(dest_image); // frees data as well
+
   // free old pixmap and set new from new_pm
   free();
 
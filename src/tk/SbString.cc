@@ -46,6 +46,23 @@ namespace {
 
 const iconv_t ICONV_NULL = (iconv_t)(-1);
 
+// results per source string. there are only ever a handful in use at
+// a time, so instead of keeping an lru everything goes once it's full
+typedef std::unordered_map<std::string, std::string> StrCache;
+const size_t STRCACHE_MAX = 256;
+
+template <typename Conv>
+const std::string &cachedConvert(StrCache &cache, const std::string &src,
+                                 Conv conv) {
+  auto it = cache.find(src);
+  if (it != cache.end() )
+    return it->second;
+
+  if (cache.size() >= STRCACHE_MAX)
+    cache.clear();
+  return cache.emplace(src, conv(src) ).first->second;
+}
+
 #ifdef HAVE_FRIBIDI
 tk::SbString makeVisualFromLogical(const tk::SbString& src) {
   FriBidiCharType base = FRIBIDI_TYPE_N;
@@ -81,6 +98,16 @@ tk::SbString makeVisualFromLogical(const tk::SbString& src) {
   return result;
 } // makeVisualFromLogical
 
+// nothing to reorder without any multibyte characters
+bool isAscii(const tk::SbString &src) {
+  for (unsigned char c : src)
+    if (c & 0x80)
+      return false;
+  return true;
+}
+
+StrCache s_visual_cache;
+
 #endif
 
 } // end of anonymous namespace
@@ -98,6 +125,9 @@ BiDiString::BiDiString(const SbString& logical)
 }
 
 const SbString& BiDiString::setLogical(const SbString& logical) {
+  if (logical == m_logical)
+    return m_logical;
+
   m_logical = logical;
 #if HAVE_FRIBIDI
   if (m_logical.empty() ) {
@@ -112,7 +142,8 @@ const SbString& BiDiString::setLogical(const SbString& logical) {
 const SbString& BiDiString::visual() const {
 #if HAVE_FRIBIDI
   if (m_visual_dirty)
-    m_visual = ::makeVisualFromLogical(logical() );
+    m_visual = isAscii(m_logical) ? m_logical :
+        cachedConvert(s_visual_cache, m_logical, makeVisualFromLogical);
   m_visual_dirty = false;
   return m_visual;
 #else
@@ -133,6 +164,7 @@ enum ConvType {
 
 static bool s_inited = false;
 static iconv_t s_iconv_convs[CONVSIZE];
+static StrCache s_recode_cache[CONVSIZE];
 static std::string s_locale_codeset;
 
 /// Initialise all of the iconv conversion descriptors
@@ -176,6 +208,7 @@ void shutdown() {
       iconv_close(s_iconv_convs[i]);
       s_iconv_convs[i] = ICONV_NULL;
     }
+    s_recode_cache[i].clear();
   }
 
   s_inited = false;
@@ -268,22 +301,33 @@ ISO8859-1.
 #endif // HAVE_ICONV
 }
 
+static std::string cachedRecode(ConvType type, const std::string &src) {
+#ifdef HAVE_ICONV
+  if (src.empty() || s_iconv_convs[type] == ICONV_NULL)
+    return src;
+  return cachedConvert(s_recode_cache[type], src, [type](const std::string &in) {
+                       return recode(s_iconv_convs[type], in); });
+#else
+  return src;
+#endif // HAVE_ICONV
+}
+
 SbString XStrToSb(const std::string &src) {
-  return recode(s_iconv_convs[X2SB], src);
+  return cachedRecode(X2SB, src);
 }
 
 std::string SbStrToX(const SbString &src) {
-  return recode(s_iconv_convs[SB2X], src);
+  return cachedRecode(SB2X, src);
 }
 
 
 /// Handle thislocale string encodings (strings coming from userspace)
 SbString LocaleStrToSb(const std::string &src) {
-  return recode(s_iconv_convs[LOCALE2SB], src);
+  return cachedRecode(LOCALE2SB, src);
 }
 
 std::string SbStrToLocale(const SbString &src) {
-  return recode(s_iconv_convs[SB2LOCALE], src);
+  return cachedRecode(SB2LOCALE, src);
 }
 
 bool haveUTF8() {
@@ -326,6 +370,7 @@ bool StringConvertor::setSource(const std::string &encoding) {
     if (m_iconv != ICONV_NULL)
       iconv_close(m_iconv);
     m_iconv = newiconv;
+    m_cache.clear();
     return true;
   }
 #else
@@ -335,7 +380,10 @@ bool StringConvertor::setSource(const std::string &encoding) {
 
 SbString StringConvertor::recode(const std::string &src) {
 #ifdef HAVE_ICONV
-  return SbStringUtil::recode(m_iconv, src);
+  if (m_iconv == ICONV_NULL)
+    return src;
+  return cachedConvert(m_cache, src, [this](const std::string &in) {
+                       return SbStringUtil::recode(m_iconv, in); });
 #else
   return src;
 #endif
@@ -346,6 +394,7 @@ void StringConvertor::reset() {
   if (m_iconv != ICONV_NULL)
     iconv_close(m_iconv);
   m_iconv = ICONV_NULL;
+  m_cache.clear();
 #endif
 }
 
@@ -4,12 +4,16 @@
   Base string class for bi-directional strings.
   Use this type for things converted to our internal encoding (UTF-8)
   (or just plain whatever for now if no utf-8 available)
+
+  Titles and the clock convert the same few strings over and over, so
+  iconv and fribidi results are kept per distinct string.
 */
 
 #ifndef TK_SBSTRING_HH
 #define TK_SBSTRING_HH
 
 #include <string>
+#include <unordered_map>
 
 #ifdef HAVE_ICONV
 #include <iconv.h>
@@ -73,6 +77,7 @@ private:
   iconv_t m_iconv;
 #endif
   std::string m_destencoding;
+  std::unordered_map<std::string, SbString> m_cache;
 };
 
 } // namespace tk
@@ -1,9 +1,7 @@
 // Texture.cc for Shynebox Window Manager
 
 #include "Texture.hh"
-#include "App.hh"
 #include "StringUtil.hh"
-#include <X11/Xlib.h>
 #ifdef HAVE_CSTRING
   #include <cstring>
 #else
@@ -71,28 +69,12 @@ void Texture::setFromString(const char * const texture_str) {
   } // if parentrelative
 } // setFromString
 
+// through Color so the cells are shared and freed with the texture
 void Texture::calcHiLoColors(int screen_num) {
-  Display *disp = tk::App::instance()->display();
-  Colormap colm = DefaultColormap(disp, screen_num);
-  XColor xcol;
-
-  xcol.red = ::brighten(m_color.red() );
-  xcol.green = ::brighten(m_color.green() );
-  xcol.blue = ::brighten(m_color.blue() );
-
-  if (! XAllocColor(disp, colm, &xcol) )
-    xcol.pixel = 0;
-
-  m_hicolor.setPixel(xcol.pixel);
-
-  xcol.red = ::darken(m_color.red() );
-  xcol.green = ::darken(m_color.green() );
-  xcol.blue = ::darken(m_color.blue() );
-
-  if (! XAllocColor(disp, colm, &xcol) )
-    xcol.pixel = 0;
-
-  m_locolor.setPixel(xcol.pixel);
+  m_hicolor = Color(::brighten(m_color.red() ), ::brighten(m_color.green() ),
+                    ::brighten(m_color.blue() ), screen_num);
+  m_locolor = Color(::darken(m_color.red() ), ::darken(m_color.green() ),
+                    ::darken(m_color.blue() ), screen_num);
 }
 
 } // end namespace tk
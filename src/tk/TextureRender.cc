@@ -11,6 +11,7 @@
 #include "I18n.hh"
 #include "StringUtil.hh"
 #include "ColorLUT.hh"
+#include "RenderExt.hh"
 
 #include <X11/Xutil.h>
 #include <iostream>
@@ -581,6 +582,14 @@ const RendererActions render_bevel_actions[] = {
        { tk::Texture::BEVEL2, renderBevel2 }
 };
 
+// rows (or columns) a horizontal (vertical) gradient needs before the
+// rest just repeats. 2 on each side for the bevels, 2 in the middle for
+// the interlacing, and the same odd/even as the full size so both line
+// up the same way after INVERT
+unsigned int repeatSize(unsigned int size) {
+  return size > 7 ? 6 + (size & 1) : size;
+}
+
 } // anonymous namespace
 
 namespace tk {
@@ -633,15 +642,12 @@ Pixmap TextureRender::render(const tk::Texture &texture) {
     return ParentRelative;
   else if (texture.type() & tk::Texture::SOLID)
     return renderSolid(texture);
-  else if (texture.type() & tk::Texture::GRADIENT) {
-    allocateColorTables();
+  else if (texture.type() & tk::Texture::GRADIENT)
     return renderGradient(texture);
-  }
   return None;
 }
 
-void TextureRender::allocateColorTables() {
-  const size_t s = width * height;
+void TextureRender::allocateColorTables(size_t s) {
   rgba = SB_new_nothrow RGBA[s];
   if (rgba == 0) {
     _SB_USES_NLS;
@@ -716,24 +722,46 @@ Pixmap TextureRender::renderGradient(const tk::Texture &texture) {
   }
 
   size_t i;
-  // draw gradient
+  const RendererActions *gradient = 0;
   for (i = 0; i < sizeof(render_gradient_actions)/sizeof(RendererActions); ++i) {
     if (render_gradient_actions[i].type & texture.type() ) {
-      render_gradient_actions[i].render(interlaced, width, height, rgba, from, to, control);
+      gradient = &render_gradient_actions[i];
       break;
     }
   }
 
+  // horizontal and vertical gradients only change along one side, the
+  // bevel and interlacing aside. only render the part that does not
+  // repeat and have the server fill in the rest
+  unsigned int w = width, h = height;
+  bool rows = gradient && gradient->render == renderHorizontalGradient;
+  bool cols = gradient && gradient->render == renderVerticalGradient;
+  if ((rows || cols) && RenderExt::usable(control.depth() ) ) {
+    if (rows)
+      h = repeatSize(height);
+    else
+      w = repeatSize(width);
+  }
+
+  allocateColorTables(w * h);
+
+  // draw gradient
+  if (gradient)
+    gradient->render(interlaced, w, h, rgba, from, to, control);
+
   // draw bevel
   for (i = 0; i < sizeof(render_bevel_actions)/sizeof(RendererActions); ++i) {
     if (texture.type() & render_bevel_actions[i].type) {
-      render_bevel_actions[i].render(interlaced, width, height, rgba, from, to, control);
+      render_bevel_actions[i].render(interlaced, w, h, rgba, from, to, control);
       break;
     }
   }
 
   if (inverted)
-    invertRGB(width, height, rgba);
+    invertRGB(w, h, rgba);
+
+  if (w != width || h != height)
+    return renderRepeated(w, h);
 
   return renderPixmap();
 }
@@ -763,11 +791,11 @@ Pixmap TextureRender::renderPixmap(const tk::Texture &src_texture) {
   return pm_copy.release();
 }
 
-XImage *TextureRender::renderXImage() {
+XImage *TextureRender::renderXImage(unsigned int w, unsigned int h) {
   Display *disp = tk::App::instance()->display();
   XImage *image = XCreateImage(disp,
                    control.visual(), control.depth(),
-                   ZPixmap, 0, 0, width, height, 32, 0);
+                   ZPixmap, 0, 0, w, h, 32, 0);
 
   if (! image) {
     _SB_USES_NLS;
@@ -790,7 +818,7 @@ XImage *TextureRender::renderXImage() {
                       &red_offset, &green_offset, &blue_offset,
                       0, 0, 0);
 
-  unsigned char *d = new unsigned char[image->bytes_per_line * (height + 1)];
+  unsigned char *d = new unsigned char[image->bytes_per_line * (h + 1)];
   unsigned int x, y, r, g, b, offset;
 
   unsigned char *pixel_data = d, *ppixel_data = d;
@@ -800,8 +828,8 @@ XImage *TextureRender::renderXImage() {
 
 #define TRANSFER_PIXELS(pixel_stmt, transfer_stmt) { \
   RGBA _rgba; \
-  for (y = 0, offset = 0; y < height; y++) { \
-    for (x = 0; x < width; x++, offset++) { \
+  for (y = 0, offset = 0; y < h; y++) { \
+    for (x = 0; x < w; x++, offset++) { \
       _rgba = rgba[offset]; \
       r = red_table[_rgba.r]; \
       g = green_table[_rgba.g]; \
@@ -897,18 +925,63 @@ Pixmap TextureRender::renderPixmap() {
     return None;
   }
 
-  XImage *image = renderXImage();
+  if (!putImage(pixmap, width, height) )
+    return None;
 
-  if (! image) {
+  pixmap.rotate(orientation);
+  return pixmap.release();
+} // renderPixmap
+
+// w x h from renderGradient is the full texture with the middle rows or
+// columns left out, copy the edges and repeat the middle 2
+Pixmap TextureRender::renderRepeated(unsigned int w, unsigned int h) {
+  Display *disp = tk::App::instance()->display();
+  Window root = RootWindow(disp, control.screenNumber() );
+  SbPixmap part(root, w, h, control.depth() );
+  SbPixmap pixmap(root, width, height, control.depth() );
+
+  if (part.drawable() == None || pixmap.drawable() == None) {
+    _SB_USES_NLS;
+    cerr << "tk::TextureRender::renderRepeated(): "
+         << _TK_CONSOLETEXT(Error, CreatePixmap, "Error creating pixmap",
+         "Couldn't create a pixmap - image - for some reason") << "\n";
+    return None;
+  }
+
+  if (!putImage(part, w, h) )
     return None;
+
+  GContext gc(pixmap);
+  if (h != height) {
+    pixmap.copyArea(part.drawable(), gc.gc(), 0, 0, 0, 0, width, 2);
+    RenderExt::tile(part.drawable(), 0, 2, width, 2,
+                    pixmap.drawable(), 0, 2, width, height - 4, control.depth() );
+    pixmap.copyArea(part.drawable(), gc.gc(), 0, h - 2, 0, height - 2, width, 2);
+  } else {
+    pixmap.copyArea(part.drawable(), gc.gc(), 0, 0, 0, 0, 2, height);
+    RenderExt::tile(part.drawable(), 2, 0, 2, height,
+                    pixmap.drawable(), 2, 0, width - 4, height, control.depth() );
+    pixmap.copyArea(part.drawable(), gc.gc(), w - 2, 0, width - 2, 0, 2, height);
+  }
+
+  pixmap.rotate(orientation);
+  return pixmap.release();
+} // renderRepeated
+
+bool TextureRender::putImage(SbPixmap &pixmap, unsigned int w, unsigned int h) {
+  Display *disp = tk::App::instance()->display();
+  XImage *image = renderXImage(w, h);
+
+  if (! image) {
+    return false;
   } else if (! image->data) {
     XDestroyImage(image);
-    return None;
+    return false;
   }
 
   XPutImage(disp, pixmap.drawable(),
             DefaultGC(disp, control.screenNumber() ),
-            image, 0, 0, 0, 0, width, height);
+            image, 0, 0, 0, 0, w, h);
 
   if (image->data != 0) {
     delete [] image->data;
@@ -916,9 +989,8 @@ Pixmap TextureRender::renderPixmap() {
   }
 
   XDestroyImage(image);
-  pixmap.rotate(orientation);
-  return pixmap.release();
-} // renderPixmap
+  return true;
+} // putImage
 
 } // end namespace tk
 
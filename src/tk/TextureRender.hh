@@ -15,6 +15,7 @@
 namespace tk {
 
 class ImageControl;
+class SbPixmap;
 class Texture;
 
 struct RGBA;
@@ -33,10 +34,12 @@ public:
   Pixmap renderPixmap(const tk::Texture &src_texture);
 private:
   // allocates red, green and blue for gradient rendering
-  void allocateColorTables();
+  void allocateColorTables(size_t size);
 
   Pixmap renderPixmap();
-  XImage *renderXImage();
+  Pixmap renderRepeated(unsigned int w, unsigned int h);
+  bool putImage(SbPixmap &pixmap, unsigned int w, unsigned int h);
+  XImage *renderXImage(unsigned int w, unsigned int h);
 
   ImageControl &control;
 
@@ -14,6 +14,7 @@
 #endif
 #include <iostream>
 #include <fstream>
+#include <set>
 
 using std::cerr;
 using std::ifstream;
@@ -157,12 +158,34 @@ bool ThemeManager::load(const string &filename,
   location.append("/pixmaps");
   Image::addSearchPath(location);
 
+  preloadPixmaps();
+
   for (auto &it : m_themes)
     ThemeManager::instance().loadTheme(*it);
 
   return true;
 } // ThemeManager load
 
+// decode every pixmap the style names in one go, the items then get
+// them from the image cache. the background is set by an external tool
+void ThemeManager::preloadPixmaps() {
+  const string suffix = ".pixmap";
+  std::set<string> files;
+  std::set<int> screens;
+
+  for (auto map : { &theme_map, &wild_map })
+    for (auto &[k, v] : *map)
+      if (!v.empty() && k.size() > suffix.size()
+          && k.compare(k.size() - suffix.size(), suffix.size(), suffix) == 0
+          && k.compare(0, 10, "background") != 0)
+        files.insert(v);
+
+  for (auto &it : m_themes)
+    screens.insert(it->screenNum() );
+
+  Image::preload(files, screens);
+}
+
 void ThemeManager::loadTheme(Theme &tm) {
   // send reconfiguration signal to theme and listeners
   for (auto i : tm.itemList() ) {
@@ -121,6 +121,7 @@ private:
   friend class tk::Theme; // so only theme can register itself in constructor
   bool registerTheme(tk::Theme &tm);
   bool unregisterTheme(tk::Theme &tm);
+  void preloadPixmaps();
 
   ThemeList m_themes;
   thm_str_map theme_map;
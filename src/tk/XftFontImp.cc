@@ -3,10 +3,53 @@
 #include "XftFontImp.hh"
 #include "App.hh"
 #include "SbDrawable.hh"
+#include "Debug.hh"
 
 #include <cmath>
 #include <cstdio>
 
+namespace {
+
+// strings kept per font, titles, tabs, menus and OSD text easily fit
+const size_t MAX_RUNS = 256;
+
+// all fonts, for the debug output
+unsigned long s_run_lookups = 0, s_run_hits = 0;
+
+// rgb of a pixel. on TrueColor it's in the pixel itself, scaled the same
+// way the server does, so only other visuals need the round trip
+void pixelColor(Display *disp, Visual *visual, Colormap colmap,
+                unsigned long pixel, XRenderColor &col) {
+  if (visual->c_class != TrueColor) {
+    XColor xcol;
+    xcol.pixel = pixel;
+    XQueryColor(disp, colmap, &xcol);
+    col.red = xcol.red;
+    col.green = xcol.green;
+    col.blue = xcol.blue;
+    return;
+  }
+
+  const unsigned long masks[3] = { visual->red_mask, visual->green_mask,
+                                   visual->blue_mask };
+  unsigned short *chan[3] = { &col.red, &col.green, &col.blue };
+  for (int i = 0; i < 3; i++) {
+    unsigned long mask = masks[i];
+    if (mask == 0) {
+      *chan[i] = 0;
+      continue;
+    }
+    int shift = 0;
+    while (!(mask & 1) ) {
+      mask >>= 1;
+      shift++;
+    }
+    *chan[i] = ((pixel >> shift) & mask) * 0xFFFF / mask;
+  }
+} // pixelColor
+
+} // anonymous namespace
+
 namespace tk {
 
 XftFontImp::XftFontImp(const char *name, bool utf8):
@@ -39,6 +82,7 @@ bool XftFontImp::load(const std::string &name) {
   }
 
   // destroy all old fonts and set new
+  clearRuns();
   for (int r = ROT0; r <= ROT270; r++) {
     m_xftfonts_loaded[r] = false;
     if (m_xftfonts[r] != 0) {
@@ -96,43 +140,19 @@ void XftFontImp::drawText(const SbDrawable &w, int screen, GC gc, const char* te
   XftFont *font = m_xftfonts[orient];
   XftDraw *draw = XftDrawCreate(w.display(), w.drawable(), def_visual, def_colmap);
 
+  // get foreground pixel value and convert it to XftColor
   XGCValues gc_val;
-
-  // get foreground pixel value and convert it to XRenderColor value
-  // TODO: we should probably check return status
   XGetGCValues(w.display(), gc, GCForeground, &gc_val);
 
-  // get red, green, blue values
-  XColor xcol;
-  xcol.pixel = gc_val.foreground;
-  XQueryColor(w.display(), def_colmap, &xcol);
-
-  // convert xcolor to XftColor
   XRenderColor rendcol;
-  rendcol.red = xcol.red;
-  rendcol.green = xcol.green;
-  rendcol.blue = xcol.blue;
+  pixelColor(w.display(), def_visual, def_colmap, gc_val.foreground, rendcol);
   rendcol.alpha = 0xFFFF;
   XftColor xftcolor;
   XftColorAllocValue(w.display(), def_visual, def_colmap, &rendcol, &xftcolor);
 
-  // draw string
-#ifdef HAVE_XFT_UTF8_STRING
-  if (m_utf8mode) {
-    // check the string size,
-    // if the size is zero we use the XftDrawString8 function instead.
-    XGlyphInfo ginfo;
-    XftTextExtentsUtf8(w.display(), m_xftfonts[ROT0], (XftChar8 *)text, len, &ginfo);
-    if (ginfo.xOff != 0) {
-      XftDrawStringUtf8(draw, &xftcolor, font, x, y, (XftChar8 *)text, len);
-      XftColorFree(w.display(), def_visual, def_colmap, &xftcolor);
-      XftDrawDestroy(draw);
-      return;
-    }
-  }
-#endif // HAVE_XFT_UTF8_STRING
-
-  XftDrawString8(draw, &xftcolor, font, x, y, (XftChar8 *)text, len);
+  // one glyph request, the glyphs themselves live on the server already
+  const Run &r = run(text, len);
+  XftDrawGlyphs(draw, &xftcolor, font, x, y, r.glyphs.data(), r.glyphs.size() );
 
   XftColorFree(w.display(), def_visual, def_colmap, &xftcolor);
   XftDrawDestroy(draw);
@@ -142,6 +162,71 @@ unsigned int XftFontImp::textWidth(const char* text, unsigned int len) const {
   if (m_xftfonts[ROT0] == 0)
     return 0;
 
+  return run(text, len).width;
+}
+
+void XftFontImp::clearRuns() {
+  m_runs.clear();
+  m_run_index.clear();
+}
+
+const XftFontImp::Run &XftFontImp::run(const char *text, size_t len) const {
+  std::string key(text, len);
+
+  s_run_lookups++;
+  auto it = m_run_index.find(key);
+  if (it != m_run_index.end() ) {
+    s_run_hits++;
+    m_runs.splice(m_runs.begin(), m_runs, it->second);
+  } else {
+    if (m_runs.size() >= MAX_RUNS) {
+      m_run_index.erase(m_runs.back().text);
+      m_runs.pop_back();
+    }
+    m_runs.push_front(Run() );
+    m_run_index[key] = m_runs.begin();
+
+    Run &r = m_runs.front();
+    r.text.swap(key);
+    r.width = measure(text, len);
+
+    Display *disp = App::instance()->display();
+    XftFont *font = m_xftfonts[ROT0];
+    r.glyphs.reserve(len);
+
+    // utf8 unless it has no width, then bytes like XftDrawString8
+#ifdef HAVE_XFT_UTF8_STRING
+    if (m_utf8mode) {
+      const FcChar8 *str = (const FcChar8 *)text;
+      int left = len, size;
+      FcChar32 ucs4;
+      while (left > 0 && (size = FcUtf8ToUcs4(str, &ucs4, left) ) > 0) {
+        r.glyphs.push_back(XftCharIndex(disp, font, ucs4) );
+        str += size;
+        left -= size;
+      }
+
+      XGlyphInfo ginfo;
+      XftGlyphExtents(disp, font, r.glyphs.data(), r.glyphs.size(), &ginfo);
+      if (ginfo.xOff == 0)
+        r.glyphs.clear();
+      else
+        len = 0;
+    }
+#endif // HAVE_XFT_UTF8_STRING
+
+    for (size_t i = 0; i < len; i++)
+      r.glyphs.push_back(XftCharIndex(disp, font, (unsigned char)text[i]) );
+
+    if ((s_run_lookups - s_run_hits) % 100 == 0)
+      sbdbg<<"XftFontImp: glyph runs "<<s_run_hits<<"/"<<s_run_lookups
+           <<" hits ("<<(s_run_hits * 100 / s_run_lookups)<<"%)\n";
+  }
+
+  return m_runs.front();
+} // run
+
+unsigned int XftFontImp::measure(const char* text, unsigned int len) const {
   XGlyphInfo ginfo;
   Display* disp = App::instance()->display();
 
@@ -11,6 +11,11 @@
 
 #include <X11/Xft/Xft.h>
 
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace tk {
 
 // Handles Xft font drawing
@@ -30,6 +35,23 @@ public:
   bool validOrientation(tk::Orientation orient);
 
 private:
+  // a string turned into glyph indices once, redraws send just the glyphs.
+  // indices are the same for the rotated fonts, they share the face
+  struct Run {
+    std::string text;
+    std::vector<FT_UInt> glyphs; // as XftDrawString* would pick them
+    unsigned int width;          // as textWidth() measures it
+  };
+  typedef std::list<Run> Runs;
+
+  const Run &run(const char *text, size_t len) const;
+  unsigned int measure(const char *text, unsigned int len) const;
+  void clearRuns();
+
+  // most recently used first
+  mutable Runs m_runs;
+  mutable std::unordered_map<std::string, Runs::iterator> m_run_index;
+
   XftFont *m_xftfonts[4]; // 4 possible orientations
   bool m_xftfonts_loaded[4]; // whether we've tried loading the orientation
   // rotated xft fonts don't give proper extents info, so we keep the "real"
@@ -0,0 +1,1029 @@
+// SbBench.cc for Shynebox Window Manager
+
+#include "SbBench.hh"
+
+#include "tk/EventTrace.hh"
+#include "tk/RegExp.hh"
+#include "tk/SbTime.hh"
+#include "tk/StringUtil.hh"
+
+#include <X11/Xatom.h>
+#include <X11/Xutil.h>
+#include <X11/extensions/XTest.h>
+
+#include <sys/select.h>
+#include <sys/types.h>
+#include <regex.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+
+using std::cerr;
+using std::string;
+using std::vector;
+
+namespace {
+
+const uint64_t WAIT_START = 10 * tk::SbTime::IN_SECONDS;
+const uint64_t WAIT_POLL = 50 * tk::SbTime::IN_MILLISECONDS;
+
+// what apps files match on, mostly names with the odd real regexp
+const char *const APPS_PATTERNS[] = {
+  "URxvt", "XTerm", "Alacritty", "kitty", "Firefox", "firefox", "Navigator",
+  "Chromium|Google-chrome", "Thunderbird", ".*Mozilla Thunderbird",
+  "Gimp.*", "gimp-.*", "mpv|vlc|MPlayer", "Steam", "steam_app_.*",
+  "Pidgin", "Pavucontrol", "feh", "Xmessage", "Gcr-prompter", "pop-up",
+  "browser-window", "Devtools", ".*- N?VIM", ".*YouTube.*", "[Ss]potify",
+  "libreoffice-.*", "[0-9]+ unread.*", "(Keepassxc|KeePassXC)", "Zathura",
+};
+
+// class, name and title of the made up windows, %d is the window number
+const char *const APPS_WINDOWS[][3] = {
+  { "URxvt", "urxvt", "user@host: ~/src/project%d" },
+  { "XTerm", "xterm", "make -j8 (%d)" },
+  { "firefox", "Navigator", "Page %d - Mozilla Firefox" },
+  { "Chromium", "chromium", "Tab %d - YouTube - Chromium" },
+  { "Thunderbird", "Mail", "Inbox (%d unread) - Mozilla Thunderbird" },
+  { "Gimp-2.10", "gimp", "[Untitled]-%d.0 (RGB color 8-bit gamma)" },
+  { "mpv", "gl", "video%d.mkv - mpv" },
+  { "Spotify", "spotify", "Song %d" },
+  { "libreoffice-writer", "libreoffice", "Untitled %d - LibreOffice Writer" },
+  { "Zathura", "org.pwmt.zathura", "paper%d.pdf" },
+  { "Emacs", "emacs", "*scratch* %d" },
+  // only the ends of an unparenthesized a|b|c are anchored
+  { "mpv-shim", "xvlcx", "clip%d - MPlayer" },
+  { "Chromium-browser", "chromium", "Google-chrome %d" },
+};
+
+// keys the harness presses, see keys file in setupConfig()
+const char KEY_NEXTWINDOW[] = "F8";
+const char KEY_ARRANGE[] = "F9";
+const char KEY_RELOADSTYLE[] = "F10";
+const char KEY_RECONFIGURE[] = "F11";
+
+// X errors are expected, clients die while the WM still talks to them
+int ignoreXErrors(Display *, XErrorEvent *) { return 0; }
+
+bool writeFile(const string &name, const string &content) {
+  std::ofstream out(name.c_str(), std::ofstream::trunc);
+  out << content;
+  return !out.fail();
+}
+
+void readMemory(pid_t pid, long &rss, long &hwm, long &heap) {
+  rss = hwm = heap = -1;
+  const string proc = "/proc/" + tk::StringUtil::number2String(pid);
+  std::ifstream status((proc + "/status").c_str() );
+  string line;
+  while (getline(status, line) ) {
+    if (line.compare(0, 6, "VmRSS:") == 0)
+      rss = atol(line.c_str() + 6);
+    else if (line.compare(0, 6, "VmHWM:") == 0)
+      hwm = atol(line.c_str() + 6);
+  }
+
+  // resident part of the brk heap, big mallocs (mmap) are not in here
+  // but those are pixmap/image buffers and not what fragments
+  std::ifstream smaps((proc + "/smaps").c_str() );
+  bool in_heap = false;
+  while (getline(smaps, line) ) {
+    if (line.find("[heap]") != string::npos)
+      in_heap = true;
+    else if (in_heap && line.compare(0, 4, "Rss:") == 0) {
+      heap = atol(line.c_str() + 4);
+      break;
+    }
+  }
+}
+
+pid_t spawn(const vector<string> &args, const string &log) {
+  pid_t pid = fork();
+  if (pid != 0)
+    return pid;
+
+  if (!log.empty() ) {
+    FILE *f = freopen(log.c_str(), "w", stdout);
+    if (f)
+      dup2(fileno(stdout), fileno(stderr) );
+  }
+
+  vector<char*> argv;
+  for (auto &a : args)
+    argv.push_back(const_cast<char*>(a.c_str() ) );
+  argv.push_back(0);
+
+  execvp(argv[0], argv.data() );
+  cerr << "sbbench: failed to exec " << args[0] << "\n";
+  _exit(EXIT_FAILURE);
+}
+
+void stopChild(pid_t &pid) {
+  if (pid <= 0)
+    return;
+  kill(pid, SIGTERM);
+  for (int i = 0; i < 40; i++) {
+    if (waitpid(pid, 0, WNOHANG) != 0) {
+      pid = 0;
+      return;
+    }
+    usleep(WAIT_POLL / 2);
+  }
+  kill(pid, SIGKILL);
+  waitpid(pid, 0, 0);
+  pid = 0;
+}
+
+// quoted JSON string, errors carry window titles and file names
+string jsonString(const string &in) {
+  string out = "\"";
+  char buf[8];
+  for (unsigned char c : in) {
+    switch (c) {
+    case '"':  out += "\\\""; break;
+    case '\\': out += "\\\\"; break;
+    case '\n': out += "\\n"; break;
+    case '\t': out += "\\t"; break;
+    default:
+      if (c < 0x20) {
+        snprintf(buf, sizeof(buf), "\\u%04x", c);
+        out += buf;
+      } else
+        out += c;
+    }
+  }
+  return out + '"';
+}
+
+} // anonymous namespace
+
+SbBench::Options::Options() :
+  wm("shynebox"),
+  geometry("1920x1080"),
+  clients(100),
+  rounds(20),
+  cycles(10),
+  keep(false) { }
+
+SbBench::SbBench(const Options &opts) : m_opts(opts) { }
+
+SbBench::~SbBench() {
+  if (m_display)
+    XCloseDisplay(m_display);
+  stopChildren();
+  cleanupConfig();
+}
+
+int SbBench::run() {
+  if (!setupConfig() || !startServer() || !startWM() ) {
+    stopChildren();
+    return EXIT_FAILURE;
+  }
+
+  sampleMemory("start");
+
+  if (wantScenario("map") )       benchMap();
+  if (wantScenario("workspace") ) benchWorkspaceSwitch();
+  if (wantScenario("focus") )     benchFocus();
+  if (wantScenario("style") )     benchStyleReload();
+  if (wantScenario("arrange") )   benchArrange();
+  if (wantScenario("placement") ) benchPlacement();
+  if (wantScenario("memory") )    benchMemory();
+  if (wantScenario("patterns") )  benchPatterns();
+  if (wantScenario("replay") )    benchReplay();
+
+  sampleMemory("end");
+
+  if (m_opts.output.empty() )
+    writeJSON(std::cout);
+  else {
+    std::ofstream out(m_opts.output.c_str(), std::ofstream::trunc);
+    writeJSON(out);
+    if (out.fail() ) {
+      cerr << "sbbench: could not write " << m_opts.output << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  return m_errors.empty() ? EXIT_SUCCESS : EXIT_FAILURE;
+} // run
+
+bool SbBench::knownScenario(const string &name) {
+  static const char *const names[] = {
+    "map", "workspace", "focus", "style", "arrange", "placement",
+    "memory", "patterns"
+  };
+  for (auto n : names)
+    if (name == n)
+      return true;
+  return false;
+}
+
+bool SbBench::wantScenario(const char *name) const {
+  if (strcmp(name, "replay") == 0)
+    return !m_opts.replay.empty();
+
+  if (m_opts.scenarios.empty() )
+    return m_opts.replay.empty();
+
+  vector<string> list;
+  tk::StringUtil::stringtok(list, m_opts.scenarios, ", ");
+  return std::find(list.begin(), list.end(), name) != list.end();
+}
+
+/////////////////////////////////////////////////////
+// setup
+
+// config dir is handed to the WM as $XDG_CONFIG_HOME
+// so nothing from the users own config leaks in
+bool SbBench::setupConfig() {
+  char tmpl[] = "/tmp/sbbench.XXXXXX";
+  if (!mkdtemp(tmpl) ) {
+    cerr << "sbbench: could not create temp dir\n";
+    return false;
+  }
+  m_cfgdir = tmpl;
+
+  string dir = m_cfgdir + "/shynebox";
+  if (mkdir(dir.c_str(), 0700) != 0)
+    return false;
+
+  // placement starts cheap, benchPlacement() switches
+  // to min overlap to measure the difference
+  string init =
+    "workspaces: 4\n"
+    "workspaceNames: 1,2,3,4\n"
+    "windowPlacement: CENTERPLACEMENT\n"
+    "focusNewWindows: true\n"
+    "toolbar.visible: true\n";
+
+  string keys = string() +
+    KEY_NEXTWINDOW + " :NextWindow\n" +
+    KEY_ARRANGE + " :ArrangeWindows\n" +
+    KEY_RELOADSTYLE + " :ReloadStyle\n" +
+    KEY_RECONFIGURE + " :Reconfigure\n";
+
+  return writeFile(dir + "/init", init)
+      && writeFile(dir + "/keys", keys)
+      && writeFile(dir + "/apps", "");
+}
+
+void SbBench::cleanupConfig() {
+  if (m_cfgdir.empty() || m_opts.keep)
+    return;
+
+  string dir = m_cfgdir + "/shynebox";
+  const char *files[] = { "init", "keys", "apps", "menu", "overlay",
+                          "windowmenu", "log" };
+  for (auto f : files)
+    unlink((dir + "/" + f).c_str() );
+  rmdir(dir.c_str() );
+  rmdir(m_cfgdir.c_str() );
+  m_cfgdir.clear();
+}
+
+bool SbBench::startServer() {
+  if (m_opts.display.empty() )
+    m_opts.display = m_opts.server.empty() ? "" : ":99";
+
+  if (!m_opts.server.empty() ) {
+    vector<string> args;
+    tk::StringUtil::stringtok(args, m_opts.server, " ");
+    args.push_back(m_opts.display);
+    if (m_opts.server.find("Xvfb") != string::npos) {
+      args.push_back("-screen");
+      args.push_back("0");
+      args.push_back(m_opts.geometry + "x24");
+    } else {
+      args.push_back("-screen");
+      args.push_back(m_opts.geometry);
+    }
+    args.push_back("-nolisten");
+    args.push_back("tcp");
+
+    m_server_pid = spawn(args, "");
+  }
+
+  XSetErrorHandler(ignoreXErrors);
+
+  const char *dpy = m_opts.display.empty() ? 0 : m_opts.display.c_str();
+  uint64_t end = tk::SbTime::mono() + WAIT_START;
+  while (!(m_display = XOpenDisplay(dpy) ) && tk::SbTime::mono() < end)
+    usleep(WAIT_POLL);
+
+  if (!m_display) {
+    cerr << "sbbench: could not connect to display '" << m_opts.display << "'\n";
+    return false;
+  }
+
+  int ev, err, major, minor;
+  if (!XTestQueryExtension(m_display, &ev, &err, &major, &minor) ) {
+    cerr << "sbbench: XTEST extension is missing\n";
+    return false;
+  }
+
+  m_root = DefaultRootWindow(m_display);
+  m_net_frame_extents = XInternAtom(m_display, "_NET_FRAME_EXTENTS", False);
+  m_net_request_extents = XInternAtom(m_display, "_NET_REQUEST_FRAME_EXTENTS", False);
+  m_net_current_desktop = XInternAtom(m_display, "_NET_CURRENT_DESKTOP", False);
+  m_net_wm_desktop = XInternAtom(m_display, "_NET_WM_DESKTOP", False);
+  m_net_active_window = XInternAtom(m_display, "_NET_ACTIVE_WINDOW", False);
+  m_net_supporting_wm = XInternAtom(m_display, "_NET_SUPPORTING_WM_CHECK", False);
+
+  // never mapped, only used to see when the WM caught up
+  m_barrier_win = XCreateSimpleWindow(m_display, m_root, 0, 0, 1, 1, 0, 0, 0);
+  XSelectInput(m_display, m_barrier_win, PropertyChangeMask);
+  XSync(m_display, False);
+
+  return true;
+} // startServer
+
+bool SbBench::startWM() {
+  string dir = m_cfgdir + "/shynebox";
+
+  // the WM gets the display from argv, config from env
+  setenv("XDG_CONFIG_HOME", m_cfgdir.c_str(), 1);
+
+  vector<string> args = { m_opts.wm, "-rc", dir + "/init" };
+  if (!m_opts.display.empty() ) {
+    args.push_back("-display");
+    args.push_back(m_opts.display);
+  }
+
+  m_wm_pid = spawn(args, dir + "/log");
+
+  uint64_t end = tk::SbTime::mono() + WAIT_START;
+  while (tk::SbTime::mono() < end) {
+    Atom type;
+    int format;
+    unsigned long count, after;
+    unsigned char *data = 0;
+    if (XGetWindowProperty(m_display, m_root, m_net_supporting_wm,
+                           0, 1, False, XA_WINDOW, &type, &format,
+                           &count, &after, &data) == Success && data) {
+      XFree(data);
+      if (count == 1 && barrier() )
+        return true;
+    }
+
+    if (waitpid(m_wm_pid, 0, WNOHANG) != 0) {
+      m_wm_pid = 0;
+      break;
+    }
+    usleep(WAIT_POLL);
+  }
+
+  cerr << "sbbench: WM did not come up, see " << dir << "/log\n";
+  m_opts.keep = true;
+  return false;
+} // startWM
+
+void SbBench::stopChildren() {
+  stopChild(m_wm_pid);
+  stopChild(m_server_pid);
+}
+
+/////////////////////////////////////////////////////
+// helpers
+
+bool SbBench::nextEvent(XEvent &ev, uint64_t timeout) {
+  uint64_t end = tk::SbTime::mono() + timeout;
+  int fd = ConnectionNumber(m_display);
+
+  while (!XPending(m_display) ) {
+    uint64_t now = tk::SbTime::mono();
+    if (now >= end)
+      return false;
+
+    fd_set rfds;
+    FD_ZERO(&rfds);
+    FD_SET(fd, &rfds);
+    timeval tv;
+    tv.tv_sec = (end - now) / tk::SbTime::IN_SECONDS;
+    tv.tv_usec = (end - now) % tk::SbTime::IN_SECONDS;
+    select(fd + 1, &rfds, 0, 0, &tv);
+  }
+
+  XNextEvent(m_display, &ev);
+  return true;
+}
+
+// drops everything that isn't the event we are waiting for
+bool SbBench::waitFor(Window win, int type, uint64_t timeout) {
+  uint64_t end = tk::SbTime::mono() + timeout;
+  XEvent ev;
+  uint64_t now;
+  while ((now = tk::SbTime::mono() ) < end && nextEvent(ev, end - now) ) {
+    if (ev.type == type && ev.xany.window == win)
+      return true;
+  }
+  return false;
+}
+
+void SbBench::clientMessage(Window win, Atom type, long l0, long l1, long l2) {
+  XEvent ev;
+  memset(&ev, 0, sizeof(ev) );
+  ev.xclient.type = ClientMessage;
+  ev.xclient.window = win;
+  ev.xclient.message_type = type;
+  ev.xclient.format = 32;
+  ev.xclient.data.l[0] = l0;
+  ev.xclient.data.l[1] = l1;
+  ev.xclient.data.l[2] = l2;
+  XSendEvent(m_display, m_root, False,
+             SubstructureRedirectMask | SubstructureNotifyMask, &ev);
+}
+
+bool SbBench::barrier() {
+  clientMessage(m_barrier_win, m_net_request_extents, 0);
+  XFlush(m_display);
+
+  uint64_t end = tk::SbTime::mono() + 5 * tk::SbTime::IN_SECONDS;
+  XEvent ev;
+  uint64_t now;
+  while ((now = tk::SbTime::mono() ) < end && nextEvent(ev, end - now) ) {
+    if (ev.type == PropertyNotify && ev.xproperty.window == m_barrier_win
+        && ev.xproperty.atom == m_net_frame_extents)
+      return true;
+  }
+
+  m_errors.push_back("barrier timed out");
+  return false;
+}
+
+Window SbBench::createClient(int num, const char *wm_class) {
+  int w = 200 + (num * 37) % 400,
+      h = 150 + (num * 53) % 300;
+  Window win = XCreateSimpleWindow(m_display, m_root, 0, 0, w, h, 0,
+                                   BlackPixel(m_display, DefaultScreen(m_display) ),
+                                   WhitePixel(m_display, DefaultScreen(m_display) ) );
+  XSelectInput(m_display, win, StructureNotifyMask);
+
+  string title = string(wm_class) + " " + tk::StringUtil::number2String(num);
+  XStoreName(m_display, win, title.c_str() );
+
+  XClassHint hint;
+  hint.res_name = const_cast<char*>(wm_class);
+  hint.res_class = const_cast<char*>(wm_class);
+  XSetClassHint(m_display, win, &hint);
+
+  return win;
+}
+
+// managed == the WM reparented and mapped the client
+bool SbBench::mapAndWait(Window win, uint64_t &took) {
+  uint64_t start = tk::SbTime::mono();
+  XMapWindow(m_display, win);
+  XFlush(m_display);
+  bool ok = waitFor(win, MapNotify);
+  took = tk::SbTime::mono() - start;
+  return ok;
+}
+
+void SbBench::destroyClients(vector<Window> &wins) {
+  for (auto w : wins)
+    XDestroyWindow(m_display, w);
+  wins.clear();
+  barrier();
+}
+
+void SbBench::sendToWorkspace(Window win, long ws) {
+  clientMessage(win, m_net_wm_desktop, ws);
+}
+
+void SbBench::pressKey(const char *keysym) {
+  KeyCode code = XKeysymToKeycode(m_display, XStringToKeysym(keysym) );
+  XTestFakeKeyEvent(m_display, code, True, CurrentTime);
+  XTestFakeKeyEvent(m_display, code, False, CurrentTime);
+  XFlush(m_display);
+}
+
+void SbBench::sampleMemory(const char *tag) {
+  if (m_wm_pid <= 0)
+    return;
+  Memory mem;
+  mem.tag = tag;
+  readMemory(m_wm_pid, mem.rss, mem.hwm, mem.heap);
+  m_memory.push_back(mem);
+}
+
+/////////////////////////////////////////////////////
+// scenarios
+
+void SbBench::benchMap() {
+  Stat &stat = m_stats["map_latency"];
+  uint64_t took;
+
+  for (int i = 0; i < m_opts.clients; i++) {
+    Window win = createClient(i, "sbbench");
+    m_clients.push_back(win);
+    if (mapAndWait(win, took) )
+      stat.add(took);
+    else
+      m_errors.push_back("client " + tk::StringUtil::number2String(i)
+                         + " was never managed");
+  }
+  barrier();
+  sampleMemory("after_map");
+}
+
+// half the clients go to workspace 2, then flip between the two
+void SbBench::benchWorkspaceSwitch() {
+  Stat &stat = m_stats["workspace_switch"];
+
+  for (size_t i = 0; i < m_clients.size(); i += 2)
+    sendToWorkspace(m_clients[i], 1);
+  barrier();
+
+  for (int r = 0; r < m_opts.rounds * 2; r++) {
+    uint64_t start = tk::SbTime::mono();
+    clientMessage(m_root, m_net_current_desktop, (r + 1) % 2);
+    if (barrier() )
+      stat.add(tk::SbTime::mono() - start);
+  }
+
+  clientMessage(m_root, m_net_current_desktop, 0);
+  barrier();
+}
+
+// every focus change reorders the focus lists and the iconbar
+// activate clients in a scrambled order, then cycle with NextWindow
+void SbBench::benchFocus() {
+  Stat &activate = m_stats["focus_activate"];
+  Stat &cycle = m_stats["focus_cycle"];
+
+  if (m_clients.empty() )
+    return;
+
+  // the workspace scenario leaves half of them on workspace 2
+  for (auto win : m_clients)
+    sendToWorkspace(win, 0);
+  barrier();
+
+  // same scrambled order on every run
+  vector<Window> order(m_clients);
+  std::mt19937 rng(42);
+
+  for (int r = 0; r < m_opts.rounds; r++) {
+    std::shuffle(order.begin(), order.end(), rng);
+    for (auto win : order) {
+      uint64_t start = tk::SbTime::mono();
+      // source 2, a pager asked for it, so focus stealing rules stay out
+      clientMessage(win, m_net_active_window, 2, CurrentTime);
+      if (barrier() )
+        activate.add(tk::SbTime::mono() - start);
+    }
+  }
+
+  for (int r = 0; r < m_opts.rounds * 10; r++) {
+    uint64_t start = tk::SbTime::mono();
+    pressKey(KEY_NEXTWINDOW);
+    if (barrier() )
+      cycle.add(tk::SbTime::mono() - start);
+  }
+} // benchFocus
+
+void SbBench::benchStyleReload() {
+  Stat &stat = m_stats["style_reload"];
+
+  for (int r = 0; r < m_opts.rounds; r++) {
+    uint64_t start = tk::SbTime::mono();
+    pressKey(KEY_RELOADSTYLE);
+    if (barrier() )
+      stat.add(tk::SbTime::mono() - start);
+  }
+}
+
+void SbBench::benchArrange() {
+  Stat &stat = m_stats["arrange_windows"];
+
+  for (int r = 0; r < m_opts.rounds; r++) {
+    uint64_t start = tk::SbTime::mono();
+    pressKey(KEY_ARRANGE);
+    if (barrier() )
+      stat.add(tk::SbTime::mono() - start);
+  }
+}
+
+// maps extra clients onto the crowded workspace with
+// center placement and again with min overlap placement
+// the difference is what the placement itself costs
+void SbBench::benchPlacement() {
+  const int count = std::max(1, m_opts.clients / 4);
+  const char *policies[] = { "CENTERPLACEMENT", "ROWMINOVERLAPPLACEMENT" };
+  const char *names[] = { "place_center", "place_minoverlap" };
+  string init_file = m_cfgdir + "/shynebox/init";
+
+  for (int p = 0; p < 2; p++) {
+    writeFile(init_file,
+      string("workspaces: 4\n"
+             "workspaceNames: 1,2,3,4\n"
+             "focusNewWindows: true\n"
+             "toolbar.visible: true\n"
+             "windowPlacement: ") + policies[p] + "\n");
+
+    // reconfigure runs off a timer once the WM is idle
+    pressKey(KEY_RECONFIGURE);
+    barrier();
+    usleep(WAIT_POLL * 2);
+    barrier();
+
+    Stat &stat = m_stats[names[p]];
+    vector<Window> extra;
+    uint64_t took;
+    for (int i = 0; i < count; i++) {
+      Window win = createClient(m_opts.clients + i, "sbbench-place");
+      extra.push_back(win);
+      if (mapAndWait(win, took) )
+        stat.add(took);
+    }
+    destroyClients(extra);
+  }
+}
+
+// create and destroy windows, the WM should settle back
+// to where it was after the first map
+void SbBench::benchMemory() {
+  const int count = std::min(m_opts.clients, 50);
+  Stat &stat = m_stats["churn_cycle"];
+
+  sampleMemory("before_churn");
+
+  for (int c = 0; c < m_opts.cycles; c++) {
+    uint64_t start = tk::SbTime::mono();
+    vector<Window> wins;
+    uint64_t took;
+    for (int i = 0; i < count; i++) {
+      Window win = createClient(i, "sbbench-churn");
+      wins.push_back(win);
+      mapAndWait(win, took);
+    }
+    if (c == m_opts.cycles - 1)
+      sampleMemory("churn_mapped");
+    destroyClients(wins);
+    stat.add(tk::SbTime::mono() - start);
+  }
+
+  sampleMemory("after_churn");
+}
+
+// every pattern against class, name and title of every window, like
+// the apps file does for new windows. one sample is one full pass
+void SbBench::benchPatterns() {
+  Stat &fast = m_stats["pattern_match"];
+  Stat &slow = m_stats["pattern_regexec"];
+
+  vector<string> props;
+  char buf[128];
+  const size_t num_apps = sizeof(APPS_WINDOWS) / sizeof(APPS_WINDOWS[0]);
+  for (int i = 0; i < m_opts.clients; i++) {
+    const char *const *app = APPS_WINDOWS[i % num_apps];
+    props.push_back(app[0]);
+    props.push_back(app[1]);
+    snprintf(buf, sizeof(buf), app[2], i);
+    props.push_back(buf);
+  }
+
+  vector<const char *> patterns;
+  vector<tk::RegExp *> regexps;
+  vector<regex_t> compiled;
+  for (auto pat : APPS_PATTERNS) {
+    regex_t re;
+    if (regcomp(&re, ("^" + string(pat) + "$").c_str(),
+                REG_NOSUB | REG_EXTENDED) != 0) {
+      m_errors.push_back(string("regcomp failed on apps pattern ") + pat);
+      continue;
+    }
+    patterns.push_back(pat);
+    regexps.push_back(new tk::RegExp(pat, true) );
+    compiled.push_back(re);
+  }
+
+  // same answer for every pattern and window, not just the same total
+  for (size_t p = 0; p < regexps.size(); p++) {
+    for (auto &prop : props) {
+      if (regexps[p]->match(prop)
+          != (regexec(&compiled[p], prop.c_str(), 0, 0, 0) == 0) ) {
+        m_errors.push_back("tk::RegExp and regexec disagree on '" + prop
+                           + "' with apps pattern " + patterns[p]);
+        break;
+      }
+    }
+  }
+
+  // keeps the loops from being thrown out
+  size_t hits_fast = 0, hits_slow = 0;
+  for (int r = 0; r < m_opts.rounds; r++) {
+    uint64_t start = tk::SbTime::mono();
+    for (auto &prop : props)
+      for (auto re : regexps)
+        hits_fast += re->match(prop);
+    fast.add(tk::SbTime::mono() - start);
+
+    start = tk::SbTime::mono();
+    for (auto &prop : props)
+      for (auto &re : compiled)
+        hits_slow += regexec(&re, prop.c_str(), 0, 0, 0) == 0;
+    slow.add(tk::SbTime::mono() - start);
+  }
+
+  if (hits_fast != hits_slow)
+    m_errors.push_back("tk::RegExp and regexec disagree on the apps patterns");
+
+  for (auto re : regexps)
+    delete re;
+  for (auto &re : compiled)
+    regfree(&re);
+} // benchPatterns
+
+// recreates the client side of a 'shynebox -trace' recording: windows are
+// created, changed and destroyed like the traced clients did it and input
+// goes through XTest. what the WM did on its own (frames, menus, root
+// properties) is left out, the WM under test does that again.
+// runs as fast as the WM keeps up, every action ends with a barrier.
+void SbBench::benchReplay() {
+  using tk::EventTrace::Record;
+
+  tk::EventTrace::Reader trace;
+  if (!trace.open(m_opts.replay) ) {
+    m_errors.push_back("replay: " + trace.error() );
+    return;
+  }
+
+  std::map<Window, Window> wins;           // traced -> ours
+  std::map<Window, Record> geometry;       // waiting for the MapRequest
+  std::map<Window, vector<Record> > props; // "
+  std::map<Atom, Atom> atoms;              // traced -> ours
+  std::map<string, Atom> names;
+  Window traced_root = None;
+  int screen = DefaultScreen(m_display);
+  unsigned int played = 0, skipped = 0;
+
+  auto atom = [&](const string &name) {
+    auto it = names.find(name);
+    if (it != names.end() )
+      return it->second;
+    return names[name] = XInternAtom(m_display, name.c_str(), False);
+  };
+  auto ours = [&](Window traced) {
+    auto it = wins.find(traced);
+    return it == wins.end() ? None : it->second;
+  };
+  auto setProperty = [&](Window win, const Record &rec) {
+    if (rec.kind == tk::EventTrace::DELETE)
+      XDeleteProperty(m_display, win, atom(rec.name) );
+    else
+      XChangeProperty(m_display, win, atom(rec.name), atom(rec.type),
+                      rec.format, PropModeReplace, rec.data.data(), rec.nitems);
+  };
+  auto timed = [&](const char *stat, uint64_t start) {
+    if (barrier() )
+      m_stats[stat].add(tk::SbTime::mono() - start);
+    played++;
+  };
+
+  uint64_t replay_start = tk::SbTime::mono();
+  Record rec;
+
+  while (trace.next(rec) ) {
+    Window win;
+
+    switch (rec.kind) {
+    case tk::EventTrace::ATOM:
+      atoms[rec.window] = atom(rec.name);
+      continue;
+    case tk::EventTrace::GEOMETRY:
+      geometry[rec.window] = rec;
+      continue;
+    case tk::EventTrace::PROPERTY:
+    case tk::EventTrace::DELETE: {
+      if ((win = ours(rec.window) ) == None) {
+        props[rec.window].push_back(rec);
+        continue;
+      }
+      uint64_t start = tk::SbTime::mono();
+      setProperty(win, rec);
+      timed("replay_property", start);
+      continue;
+    }
+    default:
+      break;
+    }
+
+    XEvent &ev = rec.event;
+    uint64_t start = tk::SbTime::mono();
+
+    switch (ev.type) {
+    case MapRequest:
+      traced_root = ev.xmaprequest.parent;
+      if ((win = ours(ev.xmaprequest.window) ) == None) {
+        Record &geom = geometry[ev.xmaprequest.window];
+        win = XCreateSimpleWindow(m_display, m_root, geom.x, geom.y,
+                                  geom.width ? geom.width : 400,
+                                  geom.height ? geom.height : 300, 0,
+                                  BlackPixel(m_display, screen),
+                                  WhitePixel(m_display, screen) );
+        XSelectInput(m_display, win, StructureNotifyMask);
+        for (auto &p : props[ev.xmaprequest.window])
+          setProperty(win, p);
+        props.erase(ev.xmaprequest.window);
+        geometry.erase(ev.xmaprequest.window);
+        wins[ev.xmaprequest.window] = win;
+      }
+      XMapWindow(m_display, win);
+      XFlush(m_display);
+      waitFor(win, MapNotify);
+      timed("replay_map", start);
+      break;
+    case ConfigureRequest: {
+      if ((win = ours(ev.xconfigurerequest.window) ) == None) {
+        skipped++;
+        break;
+      }
+      XWindowChanges wc;
+      wc.x = ev.xconfigurerequest.x;
+      wc.y = ev.xconfigurerequest.y;
+      wc.width = ev.xconfigurerequest.width;
+      wc.height = ev.xconfigurerequest.height;
+      wc.border_width = ev.xconfigurerequest.border_width;
+      wc.stack_mode = ev.xconfigurerequest.detail;
+      XConfigureWindow(m_display, win,
+                       ev.xconfigurerequest.value_mask & ~CWSibling, &wc);
+      timed("replay_configure", start);
+      break;
+    }
+    case DestroyNotify:
+      if ((win = ours(ev.xdestroywindow.window) ) == None) {
+        skipped++;
+        break;
+      }
+      XDestroyWindow(m_display, win);
+      wins.erase(ev.xdestroywindow.window);
+      timed("replay_destroy", start);
+      break;
+    case ClientMessage: {
+      win = ours(ev.xclient.window);
+      if (win == None && ev.xclient.window == traced_root)
+        win = m_root;
+      auto type = atoms.find(ev.xclient.message_type);
+      if (win == None || type == atoms.end() ) {
+        skipped++;
+        break;
+      }
+
+      XEvent msg = ev;
+      msg.xclient.display = m_display;
+      msg.xclient.window = win;
+      msg.xclient.message_type = type->second;
+      msg.xclient.send_event = True;
+      for (int i = 1; i < 3; i++) { // _NET_WM_STATE properties
+        auto a = atoms.find(msg.xclient.data.l[i]);
+        if (a != atoms.end() )
+          msg.xclient.data.l[i] = a->second;
+      }
+      XSendEvent(m_display, m_root, False,
+                 SubstructureRedirectMask | SubstructureNotifyMask, &msg);
+      timed("replay_message", start);
+      break;
+    }
+    case KeyPress:
+    case KeyRelease:
+      XTestFakeKeyEvent(m_display, ev.xkey.keycode, ev.type == KeyPress,
+                        CurrentTime);
+      timed("replay_key", start);
+      break;
+    case ButtonPress:
+    case ButtonRelease:
+      XTestFakeMotionEvent(m_display, screen, ev.xbutton.x_root,
+                           ev.xbutton.y_root, CurrentTime);
+      XTestFakeButtonEvent(m_display, ev.xbutton.button,
+                           ev.type == ButtonPress, CurrentTime);
+      timed("replay_button", start);
+      break;
+    case MotionNotify:
+      XTestFakeMotionEvent(m_display, screen, ev.xmotion.x_root,
+                           ev.xmotion.y_root, CurrentTime);
+      timed("replay_motion", start);
+      break;
+    default: // the WM's own doing or plain notifies
+      skipped++;
+      break;
+    }
+  } // while records
+
+  // a short read ends the replay, the total of half a trace means nothing
+  if (!trace.error().empty() )
+    m_errors.push_back("replay: " + trace.error() );
+  else
+    m_stats["replay_total"].add(tk::SbTime::mono() - replay_start);
+  sampleMemory("after_replay");
+
+  cerr << "sbbench: replayed " << played << " actions, skipped "
+       << skipped << " events\n";
+
+  for (auto it : wins)
+    XDestroyWindow(m_display, it.second);
+  barrier();
+} // benchReplay
+
+/////////////////////////////////////////////////////
+// output
+
+void SbBench::Stat::write(std::ostream &os) const {
+  vector<uint64_t> s(samples);
+  std::sort(s.begin(), s.end() );
+
+  uint64_t sum = 0;
+  for (auto v : s)
+    sum += v;
+
+  os << "{ \"count\": " << s.size();
+  if (!s.empty() ) {
+    os << ", \"min\": " << s.front()
+       << ", \"median\": " << s[s.size() / 2]
+       << ", \"mean\": " << sum / s.size()
+       << ", \"p95\": " << s[std::min(s.size() - 1, (s.size() * 95) / 100)]
+       << ", \"max\": " << s.back();
+  }
+  os << " }";
+}
+
+void SbBench::writeJSON(std::ostream &os) const {
+  os << "{\n"
+     << "  \"wm\": " << jsonString(m_opts.wm) << ",\n"
+     << "  \"clients\": " << m_opts.clients << ",\n"
+     << "  \"rounds\": " << m_opts.rounds << ",\n"
+     << "  \"cycles\": " << m_opts.cycles << ",\n"
+     << "  \"unit\": \"us\",\n"
+     << "  \"results\": {";
+
+  const char *sep = "\n";
+  for (auto &[name, stat] : m_stats) {
+    os << sep << "    " << jsonString(name) << ": ";
+    stat.write(os);
+    sep = ",\n";
+  }
+  os << "\n  },\n"
+     << "  \"memory_kb\": {";
+
+  sep = "\n";
+  for (auto &mem : m_memory) {
+    os << sep << "    " << jsonString(mem.tag) << ": { \"rss\": " << mem.rss
+       << ", \"hwm\": " << mem.hwm << ", \"heap\": " << mem.heap << " }";
+    sep = ",\n";
+  }
+  os << "\n  },\n";
+
+  // growth between the first full map and the end of the run
+  // heap: peak of all samples, steady is what is left after the churn
+  long growth = 0, base = -1;
+  long heap_peak = -1, heap_steady = -1;
+  for (auto &mem : m_memory) {
+    if (base < 0 && mem.tag == "after_map")
+      base = mem.rss;
+    if (base >= 0)
+      growth = mem.rss - base;
+    heap_peak = std::max(heap_peak, mem.heap);
+    if (mem.tag == "after_churn")
+      heap_steady = mem.heap;
+  }
+  os << "  \"memory_growth_kb\": " << growth << ",\n"
+     << "  \"heap_peak_kb\": " << heap_peak << ",\n"
+     << "  \"heap_steady_kb\": " << heap_steady << ",\n"
+     << "  \"errors\": [";
+
+  sep = "";
+  for (auto &e : m_errors) {
+    os << sep << jsonString(e);
+    sep = ", ";
+  }
+  os << "]\n}\n";
+} // writeJSON
+
+// Copyright (c) 2023 Shynebox - zlice
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
@@ -0,0 +1,152 @@
+// SbBench.hh for Shynebox Window Manager
+
+/*
+  Headless benchmark harness.
+
+  Starts an X server (Xvfb/Xephyr) or uses an existing display, launches
+  shynebox on it with a throw away config directory and then drives it
+  with synthetic clients, key presses (XTest) and EWMH client messages.
+
+  Every measurement ends with a 'barrier': a _NET_REQUEST_FRAME_EXTENTS
+  round trip through the WM. The WM handles events in order, so once the
+  reply shows up the previous request has been fully processed.
+
+  Results are written as JSON so runs can be diffed between builds.
+
+  The 'patterns' scenario runs in process. It matches apps file style
+  patterns against made up window properties with tk::RegExp, and with
+  plain regexec for comparison.
+
+  With -replay a 'shynebox -trace' recording is played back instead: the
+  traced clients are recreated and driven the way they were recorded so
+  a slow interaction can be repeated under a profiler.
+*/
+
+#ifndef SBBENCH_HH
+#define SBBENCH_HH
+
+#include <X11/Xlib.h>
+
+#include <sys/types.h>
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+class SbBench {
+public:
+  struct Options {
+    Options();
+
+    std::string wm;           // shynebox binary to test
+    std::string server;       // X server to spawn, empty = use display
+    std::string display;      // display to spawn on / connect to
+    std::string geometry;     // root size for spawned servers
+    std::string output;       // json file, empty = stdout
+    std::string scenarios;    // comma list, empty = all
+    std::string replay;       // trace from 'shynebox -trace'
+    int clients;              // synthetic clients to map
+    int rounds;               // repeats for switch/reload/arrange
+    int cycles;               // create/destroy cycles for memory growth
+    bool keep;                // keep the temp config dir
+  };
+
+  // collected samples for one measurement, all in microseconds
+  struct Stat {
+    std::vector<uint64_t> samples;
+    void add(uint64_t us) { samples.push_back(us); }
+    void write(std::ostream &os) const;
+  };
+
+  explicit SbBench(const Options &opts);
+  ~SbBench();
+
+  // returns exit code for main()
+  int run();
+  // name is one of the -scenarios main() accepts
+  static bool knownScenario(const std::string &name);
+
+private:
+  bool setupConfig();
+  bool startServer();
+  bool startWM();
+  void stopChildren();
+  void cleanupConfig();
+
+  // scenarios
+  void benchMap();
+  void benchWorkspaceSwitch();
+  void benchFocus();
+  void benchStyleReload();
+  void benchArrange();
+  void benchPlacement();
+  void benchMemory();
+  void benchPatterns();
+  void benchReplay();
+
+  bool wantScenario(const char *name) const;
+
+  // helpers
+  Window createClient(int num, const char *wm_class);
+  bool mapAndWait(Window win, uint64_t &took);
+  void destroyClients(std::vector<Window> &wins);
+  void sendToWorkspace(Window win, long ws);
+  void clientMessage(Window win, Atom type, long l0, long l1 = 0, long l2 = 0);
+  bool barrier();
+  bool nextEvent(XEvent &ev, uint64_t timeout);
+  bool waitFor(Window win, int type, uint64_t timeout = 5000000);
+  void pressKey(const char *keysym);
+  void sampleMemory(const char *tag);
+  void writeJSON(std::ostream &os) const;
+
+  Options m_opts;
+  Display *m_display = 0;
+  Window m_root = 0;
+  Window m_barrier_win = 0;
+  pid_t m_server_pid = 0;
+  pid_t m_wm_pid = 0;
+  std::string m_cfgdir;
+
+  std::vector<Window> m_clients;
+
+  Atom m_net_frame_extents = 0,
+       m_net_request_extents = 0,
+       m_net_current_desktop = 0,
+       m_net_wm_desktop = 0,
+       m_net_active_window = 0,
+       m_net_supporting_wm = 0;
+
+  // VmRSS, VmHWM and resident [heap] in kB, -1 if unknown
+  struct Memory {
+    std::string tag;
+    long rss, hwm, heap;
+  };
+
+  std::map<std::string, Stat> m_stats;
+  std::vector<Memory> m_memory;
+  std::vector<std::string> m_errors;
+};
+
+#endif // SBBENCH_HH
+
+// Copyright (c) 2023 Shynebox - zlice
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
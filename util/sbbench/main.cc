@@ -0,0 +1,115 @@
+// main.cc for SbBench
+
+#include "SbBench.hh"
+
+#include "tk/StringUtil.hh"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using std::cerr;
+using std::string;
+using std::vector;
+
+namespace {
+
+void showUsage(const char *progname) {
+  cerr << "Usage: " << progname << " [arguments]\n"
+       << "Arguments:\n"
+       << "   -wm <path>            shynebox binary to test (default: shynebox)\n"
+       << "   -server <cmd>         X server to start, e.g. Xvfb or Xephyr\n"
+       << "   -display <string>     display to start on / connect to (default :99)\n"
+       << "   -geometry <WxH>       root size for started servers (default 1920x1080)\n"
+       << "   -clients <int>        synthetic clients to map (default 100)\n"
+       << "   -rounds <int>         repeats of timed actions (default 20)\n"
+       << "   -cycles <int>         create/destroy cycles for memory (default 10)\n"
+       << "   -scenarios <list>     comma list of: map, workspace, focus,\n"
+       << "                         style, arrange, placement, memory,\n"
+       << "                         patterns (default all but replay)\n"
+       << "   -replay <file>        replay a 'shynebox -trace' recording, only\n"
+       << "                         the replay runs unless -scenarios is given\n"
+       << "   -o <file>             write JSON results to file (default stdout)\n"
+       << "   -keep                 keep temporary config dir and WM log\n"
+       << "   -help                 show this help\n\n"
+       << "Example: " << progname << " -server Xvfb -wm ./shynebox -o bench.json\n";
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv) {
+  SbBench::Options opts;
+
+  for (int i = 1; i < argc; i++) {
+    string arg = argv[i];
+    if (arg == "-wm" && i+1 < argc) {
+      opts.wm = argv[++i];
+    } else if (arg == "-server" && i+1 < argc) {
+      opts.server = argv[++i];
+    } else if ((arg == "-display" || arg == "--display") && i+1 < argc) {
+      opts.display = argv[++i];
+    } else if (arg == "-geometry" && i+1 < argc) {
+      opts.geometry = argv[++i];
+    } else if (arg == "-clients" && i+1 < argc) {
+      opts.clients = atoi(argv[++i]);
+    } else if (arg == "-rounds" && i+1 < argc) {
+      opts.rounds = atoi(argv[++i]);
+    } else if (arg == "-cycles" && i+1 < argc) {
+      opts.cycles = atoi(argv[++i]);
+    } else if (arg == "-scenarios" && i+1 < argc) {
+      opts.scenarios = argv[++i];
+    } else if (arg == "-replay" && i+1 < argc) {
+      opts.replay = argv[++i];
+    } else if (arg == "-o" && i+1 < argc) {
+      opts.output = argv[++i];
+    } else if (arg == "-keep") {
+      opts.keep = true;
+    } else if (arg == "-h" || arg == "-help" || arg == "--help") {
+      showUsage(argv[0]);
+      return EXIT_SUCCESS;
+    } else {
+      cerr << "Invalid argument: " << argv[i] << "\n";
+      showUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (opts.clients < 1 || opts.rounds < 1 || opts.cycles < 0) {
+    cerr << "sbbench: -clients and -rounds must be positive, "
+            "-cycles can't be negative\n";
+    return EXIT_FAILURE;
+  }
+
+  vector<string> scenarios;
+  tk::StringUtil::stringtok(scenarios, opts.scenarios, ", ");
+  for (auto &s : scenarios)
+    if (!SbBench::knownScenario(s) ) {
+      cerr << "sbbench: unknown scenario '" << s << "'\n";
+      showUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+
+  SbBench bench(opts);
+  return bench.run();
+}
+
+// Copyright (c) 2023 Shynebox - zlice
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.